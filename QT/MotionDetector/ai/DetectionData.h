@@ -12,6 +12,7 @@
     QString className;              // Class adı ("person", "car", vs)
     double confidence = 0.0;        // Güven skoru (0.0 - 1.0)
     cv::Rect bbox;                  // Bounding box (x, y, width, height)
+    int trackId = -1;               // ObjectTracker kimliği (-1: izlenmiyor)
     // Geçerli mi kontrol et
     bool isValid() const {
         return classId >= 0 && confidence > 0.0 &&
@@ -31,7 +32,9 @@
     */
     struct DetectionResult {
     int frameId = -1;                   // Hangi frame
+    int streamId = 0;                   // Hangi video akışı (frameId'ler akış başına ayrıdır)
     double processingTimeMs = 0.0;      // Python da işleme süresi
+    double roundTripMs = 0.0;           // Gönderimden cevaba kadar geçen toplam süre
     QVector<Detection> detections;      // Bulunan nesneler
     bool success = false;               // İşlem başarılı mı
     // Geçerli mi kontrol et
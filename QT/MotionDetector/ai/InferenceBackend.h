@@ -0,0 +1,46 @@
+#ifndef INFERENCEBACKEND_H
+#define INFERENCEBACKEND_H
+
+#include "ai/DetectionData.h"
+#include "core/ThreadQueue.h" // FrameQueue için
+#include <QObject>
+#include <atomic>
+
+/*
+ Nesne tespiti yapan worker'ların ortak arayüzü
+ Her backend tespit kuyruğundan frame alır ve sonucu aynı DetectionResult
+ formatında detectionReceived sinyali ile Ana Thread'e gönderir.
+ Uygulamalar: YOLOCommunicator (TCP/Python servisi), OnnxDetector (OpenCV DNN, süreç içi)
+ */
+class InferenceBackend : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InferenceBackend(FrameQueue* detectionQueue, QObject *parent = nullptr)
+        : QObject(parent),
+        detectionQueue(detectionQueue),
+        isRunning(false)
+    {
+    }
+    ~InferenceBackend() override = default;
+
+    virtual QString backendName() const = 0;
+    virtual QString getStatus() const = 0;
+
+public slots:
+    virtual void startProcessing() = 0;
+    // isRunning atomik olduğu için başka thread'den doğrudan çağrılabilir
+    virtual void stopProcessing() { isRunning = false; }
+
+signals:
+    void detectionReceived(const DetectionResult& result);
+    void connectionStatusChanged(bool connected);
+    void errorOccurred(const QString& errorMessage);
+
+protected:
+    FrameQueue* detectionQueue;
+    std::atomic<bool> isRunning;
+};
+
+#endif // INFERENCEBACKEND_H
@@ -0,0 +1,59 @@
+#include "Letterbox.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Letterbox {
+
+Info apply(const cv::Mat& src, cv::Mat& dst, int targetSize, const cv::Scalar& padColor)
+{
+    Info info;
+    info.sourceSize = src.size();
+    info.targetSize = cv::Size(targetSize, targetSize);
+
+    if (src.empty() || targetSize <= 0) {
+        return info;
+    }
+
+    info.scale = std::min(static_cast<double>(targetSize) / src.cols,
+                          static_cast<double>(targetSize) / src.rows);
+    const int resizedW = static_cast<int>(std::round(src.cols * info.scale));
+    const int resizedH = static_cast<int>(std::round(src.rows * info.scale));
+    info.padX = (targetSize - resizedW) / 2;
+    info.padY = (targetSize - resizedH) / 2;
+
+    dst.create(targetSize, targetSize, src.type());
+
+    // Sadece dolgu şeritlerini boya, ortadaki alan resize ile zaten yazılacak
+    if (info.padY > 0) {
+        dst(cv::Rect(0, 0, targetSize, info.padY)).setTo(padColor);
+        dst(cv::Rect(0, info.padY + resizedH, targetSize, targetSize - info.padY - resizedH)).setTo(padColor);
+    }
+    if (info.padX > 0) {
+        dst(cv::Rect(0, 0, info.padX, targetSize)).setTo(padColor);
+        dst(cv::Rect(info.padX + resizedW, 0, targetSize - info.padX - resizedW, targetSize)).setTo(padColor);
+    }
+
+    cv::Mat inner = dst(cv::Rect(info.padX, info.padY, resizedW, resizedH));
+    if (resizedW == src.cols && resizedH == src.rows) {
+        src.copyTo(inner);
+    } else {
+        // Küçültmede INTER_AREA daha az aliasing üretir
+        const int interpolation = info.scale < 1.0 ? cv::INTER_AREA : cv::INTER_LINEAR;
+        cv::resize(src, inner, inner.size(), 0, 0, interpolation);
+    }
+    return info;
+}
+
+cv::Rect toSource(const Info& info, float x1, float y1, float x2, float y2)
+{
+    const double inv = info.scale > 0.0 ? 1.0 / info.scale : 1.0;
+    const int left = static_cast<int>(std::round((x1 - info.padX) * inv));
+    const int top = static_cast<int>(std::round((y1 - info.padY) * inv));
+    const int right = static_cast<int>(std::round((x2 - info.padX) * inv));
+    const int bottom = static_cast<int>(std::round((y2 - info.padY) * inv));
+
+    const cv::Rect bounds(0, 0, info.sourceSize.width, info.sourceSize.height);
+    return cv::Rect(cv::Point(left, top), cv::Point(right, bottom)) & bounds;
+}
+
+} // namespace Letterbox
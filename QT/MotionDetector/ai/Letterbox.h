@@ -0,0 +1,36 @@
+#ifndef LETTERBOX_H
+#define LETTERBOX_H
+
+#include <opencv2/opencv.hpp>
+
+/*
+ YOLO modelleri için letterbox ön işleme
+ Frame en-boy oranı korunarak model giriş boyutuna küçültülür ve kalan alan
+ gri (114) ile doldurulur. Info, model koordinatlarındaki kutuları tekrar
+ kaynak frame koordinatlarına çevirmek için gerekli bilgileri tutar.
+ */
+namespace Letterbox {
+
+struct Info {
+    double scale = 1.0;         // Kaynak -> model ölçeği
+    int padX = 0;               // Soldaki dolgu (piksel)
+    int padY = 0;               // Üstteki dolgu (piksel)
+    cv::Size sourceSize;        // Orijinal frame boyutu
+    cv::Size targetSize;        // Model giriş boyutu
+
+    bool isIdentity() const {
+        return scale == 1.0 && padX == 0 && padY == 0;
+    }
+};
+
+// src'yi targetSize x targetSize boyutuna letterbox'lar. dst çağrılar arasında
+// tekrar kullanılabilir, boyutu değişmedikçe yeniden ayrılmaz.
+Info apply(const cv::Mat& src, cv::Mat& dst, int targetSize,
+           const cv::Scalar& padColor = cv::Scalar(114, 114, 114));
+
+// Model koordinatlarındaki (x1, y1, x2, y2) kutuyu kaynak frame'e çevirir, sınırlara kırpar
+cv::Rect toSource(const Info& info, float x1, float y1, float x2, float y2);
+
+} // namespace Letterbox
+
+#endif // LETTERBOX_H
@@ -0,0 +1,162 @@
+#include "SharedFrameRing.h"
+#include <QDebug>
+#include <QtGlobal>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MD_HAS_POSIX_SHM 1
+#else
+#define MD_HAS_POSIX_SHM 0
+#endif
+
+SharedFrameRing::~SharedFrameRing()
+{
+    destroy();
+}
+
+bool SharedFrameRing::isSupported()
+{
+    return MD_HAS_POSIX_SHM != 0;
+}
+
+bool SharedFrameRing::create(const QString& name, int slotCount, size_t slotSize)
+{
+    destroy();
+#if MD_HAS_POSIX_SHM
+    if (slotCount <= 0 || slotSize == 0) {
+        return false;
+    }
+
+    // Slot başlangıçları cache line hizalı olsun
+    const size_t alignedSlot = (slotSize + 63) & ~static_cast<size_t>(63);
+    const size_t totalSize = HeaderSize + alignedSlot * static_cast<size_t>(slotCount);
+    const QByteArray posixName = "/" + name.toUtf8();
+
+    shm_unlink(posixName.constData()); // Önceki çökmüş bir çalışmadan kalmış olabilir
+    fd = shm_open(posixName.constData(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        qDebug() << "SharedFrameRing: shm_open başarısız:" << std::strerror(errno);
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(totalSize)) != 0) {
+        qDebug() << "SharedFrameRing: ftruncate başarısız:" << std::strerror(errno);
+        ::close(fd);
+        fd = -1;
+        shm_unlink(posixName.constData());
+        return false;
+    }
+#if defined(Q_OS_LINUX)
+    // ftruncate sayfa ayırmaz: /dev/shm küçükse (Docker'da 64 MB) yer ancak ilk
+    // yazmada biter ve SIGBUS gelir. Sayfalar baştan ayrılır, olmazsa TCP kullanılır.
+    const int reserveError = posix_fallocate(fd, 0, static_cast<off_t>(totalSize));
+    if (reserveError != 0) {
+        qDebug() << "SharedFrameRing: posix_fallocate başarısız:" << std::strerror(reserveError)
+                 << "boyut:" << totalSize;
+        ::close(fd);
+        fd = -1;
+        shm_unlink(posixName.constData());
+        return false;
+    }
+#endif
+
+    void* mapped = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        qDebug() << "SharedFrameRing: mmap başarısız:" << std::strerror(errno);
+        ::close(fd);
+        fd = -1;
+        shm_unlink(posixName.constData());
+        return false;
+    }
+
+    base = static_cast<unsigned char*>(mapped);
+    mappedSize = totalSize;
+    bytesPerSlot = alignedSlot;
+    shmName = name;
+    slotBusy.assign(slotCount, false);
+
+    // Python tarafının doğrulayacağı başlık
+    const quint32 header[4] = {0x4853444Du /* "MDSH" */, 1u,
+                               static_cast<quint32>(slotCount),
+                               static_cast<quint32>(alignedSlot)};
+    std::memcpy(base, header, sizeof(header));
+
+    qDebug() << "SharedFrameRing: oluşturuldu" << shmName << "slot:" << slotCount
+             << "slot boyutu:" << alignedSlot;
+    return true;
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(slotCount);
+    Q_UNUSED(slotSize);
+    return false;
+#endif
+}
+
+void SharedFrameRing::destroy()
+{
+#if MD_HAS_POSIX_SHM
+    if (base) {
+        munmap(base, mappedSize);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        shm_unlink(("/" + shmName.toUtf8()).constData());
+    }
+#endif
+    base = nullptr;
+    fd = -1;
+    mappedSize = 0;
+    bytesPerSlot = 0;
+    slotBusy.clear();
+    shmName.clear();
+}
+
+int SharedFrameRing::acquireSlot()
+{
+    for (size_t i = 0; i < slotBusy.size(); ++i) {
+        if (!slotBusy[i]) {
+            slotBusy[i] = true;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void SharedFrameRing::releaseSlot(int slot)
+{
+    if (slot >= 0 && slot < slotCount()) {
+        slotBusy[slot] = false;
+    }
+}
+
+void SharedFrameRing::releaseAll()
+{
+    std::fill(slotBusy.begin(), slotBusy.end(), false);
+}
+
+bool SharedFrameRing::writeFrame(int slot, const cv::Mat& frame)
+{
+    if (!isOpen() || slot < 0 || slot >= slotCount() || frame.empty()) {
+        return false;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(frame.cols) * frame.elemSize();
+    if (rowBytes * frame.rows > bytesPerSlot) {
+        return false; // Slot'a sığmıyor, çağıran TCP yoluna döner
+    }
+
+    unsigned char* dest = base + HeaderSize + bytesPerSlot * slot;
+    if (frame.isContinuous()) {
+        std::memcpy(dest, frame.data, rowBytes * frame.rows);
+    } else {
+        for (int row = 0; row < frame.rows; ++row) {
+            std::memcpy(dest + row * rowBytes, frame.ptr(row), rowBytes);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef SHAREDFRAMERING_H
+#define SHAREDFRAMERING_H
+
+#include <QString>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/*
+ Yerel YOLO servisine frame aktarımı için POSIX shared memory halkası
+ Frame pikselleri sabit boyutlu slot'lara kopyalanır, TCP üzerinden sadece
+ slot indeksi ve frame başlığı gider. Slot, cevabı gelene kadar meşgul kalır.
+
+ Bellek düzeni (Python tarafı: python/wire_protocol.py -> SharedFrameRing):
+   [0, HeaderSize)        magic "MDSH" | version u32 | slot_count u32 | slot_size u32 (little-endian)
+   HeaderSize + i*slot    i. slot'un piksel verisi (satırlar boşluksuz)
+
+ POSIX shared memory olmayan platformlarda isSupported() false döner ve
+ YOLOCommunicator normal TCP yoluna geri düşer.
+ */
+class SharedFrameRing {
+public:
+    static constexpr size_t HeaderSize = 64;
+
+    SharedFrameRing() = default;
+    ~SharedFrameRing();
+
+    SharedFrameRing(const SharedFrameRing&) = delete;
+    SharedFrameRing& operator=(const SharedFrameRing&) = delete;
+
+    static bool isSupported();
+
+    // Segmenti oluşturur ve map eder. name başında '/' olmadan verilir.
+    bool create(const QString& name, int slotCount, size_t slotSize);
+    void destroy();
+
+    bool isOpen() const { return base != nullptr; }
+    QString name() const { return shmName; }
+    int slotCount() const { return static_cast<int>(slotBusy.size()); }
+    size_t slotSize() const { return bytesPerSlot; }
+
+    // Boş slot yoksa -1 döner
+    int acquireSlot();
+    void releaseSlot(int slot);
+    void releaseAll();
+
+    // Frame slot'a sığıyorsa satırları boşluksuz kopyalar
+    bool writeFrame(int slot, const cv::Mat& frame);
+
+private:
+    QString shmName;
+    int fd = -1;
+    unsigned char* base = nullptr;
+    size_t mappedSize = 0;
+    size_t bytesPerSlot = 0;
+    std::vector<bool> slotBusy;
+};
+
+#endif // SHAREDFRAMERING_H
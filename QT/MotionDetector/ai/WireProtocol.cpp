@@ -0,0 +1,266 @@
+#include "WireProtocol.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace WireProtocol {
+
+namespace {
+
+void writeHeader(uchar* dest, MessageType type)
+{
+    std::memcpy(dest, Magic, 4);
+    dest[4] = Version;
+    dest[5] = static_cast<quint8>(type);
+    qToBigEndian<quint16>(0, dest + 6);
+}
+
+// Uzunluk prefix'i ve ortak başlığı yazar, gövdenin başını döndürür
+uchar* beginPacket(QByteArray& packet, MessageType type, int payloadSize)
+{
+    const int bodySize = HeaderSize + payloadSize;
+    packet.resize(4 + bodySize); // Kapasite korunur, sadece büyürken ayırma yapılır
+    auto* out = reinterpret_cast<uchar*>(packet.data());
+    qToBigEndian<quint32>(static_cast<quint32>(bodySize), out);
+    writeHeader(out + 4, type);
+    return out + 4 + HeaderSize;
+}
+
+void writeFrameHeader(uchar* out, int frameId, const cv::Mat& frame, Codec codec, quint32 dataSize)
+{
+    const PixelFormat format = frame.channels() == 3 ? PixelFormat::BGR8 : PixelFormat::Gray8;
+    qToBigEndian<qint32>(frameId, out);
+    qToBigEndian<quint16>(static_cast<quint16>(frame.cols), out + 4);
+    qToBigEndian<quint16>(static_cast<quint16>(frame.rows), out + 6);
+    out[8] = static_cast<quint8>(format);
+    out[9] = static_cast<quint8>(codec);
+    qToBigEndian<quint16>(0, out + 10);
+    qToBigEndian<quint32>(dataSize, out + 12);
+}
+
+float readFloat(const uchar* src)
+{
+    const quint32 bits = qFromBigEndian<quint32>(src);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Frame'in gövdeye yazılacak verisini hazırlar (Jpeg ise encodeBuffer'a sıkıştırır)
+bool prepareFrameData(const cv::Mat& frame, Codec codec, int jpegQuality,
+                      std::vector<uchar>& encodeBuffer, size_t& dataSize)
+{
+    if (frame.empty() || frame.depth() != CV_8U ||
+        (frame.channels() != 3 && frame.channels() != 1)) {
+        return false;
+    }
+
+    if (codec == Codec::Jpeg) {
+        std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, jpegQuality};
+        if (!cv::imencode(".jpg", frame, encodeBuffer, params)) {
+            return false;
+        }
+        dataSize = encodeBuffer.size();
+        return true;
+    }
+    if (codec == Codec::Raw) {
+        dataSize = static_cast<size_t>(frame.cols) * frame.elemSize() * frame.rows;
+        return true;
+    }
+    return false; // SharedMemory için encodeSharedFrameRequest kullanılır
+}
+
+// Frame başlığı + veriyi out'a yazar, out en az FrameHeaderSize + dataSize byte olmalı
+void writeFramePayload(uchar* out, int frameId, const cv::Mat& frame, Codec codec,
+                       const std::vector<uchar>& encodeBuffer, size_t dataSize)
+{
+    writeFrameHeader(out, frameId, frame, codec, static_cast<quint32>(dataSize));
+    out += FrameHeaderSize;
+
+    const size_t rowBytes = static_cast<size_t>(frame.cols) * frame.elemSize();
+    if (codec == Codec::Jpeg) {
+        std::memcpy(out, encodeBuffer.data(), dataSize);
+    } else if (frame.isContinuous()) {
+        std::memcpy(out, frame.data, dataSize);
+    } else {
+        for (int row = 0; row < frame.rows; ++row) {
+            std::memcpy(out + row * rowBytes, frame.ptr(row), rowBytes);
+        }
+    }
+}
+
+// Paketin sonuna size byte ekler ve eklenen alanın başını döndürür
+uchar* growPacket(QByteArray& packet, int size)
+{
+    const int oldSize = packet.size();
+    packet.resize(oldSize + size);
+    return reinterpret_cast<uchar*>(packet.data()) + oldSize;
+}
+
+} // namespace
+
+MessageType peekType(const QByteArray& body)
+{
+    if (body.size() < HeaderSize || std::memcmp(body.constData(), Magic, 4) != 0) {
+        return MessageType::Invalid;
+    }
+    const auto* data = reinterpret_cast<const uchar*>(body.constData());
+    if (data[4] != Version) {
+        return MessageType::Invalid;
+    }
+    return static_cast<MessageType>(data[5]);
+}
+
+bool encodeFrameRequest(int frameId, const cv::Mat& frame, Codec codec, int jpegQuality,
+                        QByteArray& packet, std::vector<uchar>& encodeBuffer)
+{
+    size_t dataSize = 0;
+    if (!prepareFrameData(frame, codec, jpegQuality, encodeBuffer, dataSize)) {
+        return false;
+    }
+
+    uchar* out = beginPacket(packet, MessageType::FrameRequest,
+                             FrameHeaderSize + static_cast<int>(dataSize));
+    writeFramePayload(out, frameId, frame, codec, encodeBuffer, dataSize);
+    return true;
+}
+
+void encodeSharedFrameRequest(int frameId, const cv::Mat& frame, int slot, QByteArray& packet)
+{
+    uchar* out = beginPacket(packet, MessageType::FrameRequest, FrameHeaderSize + 4);
+    writeFrameHeader(out, frameId, frame, Codec::SharedMemory, 4);
+    qToBigEndian<quint32>(static_cast<quint32>(slot), out + FrameHeaderSize);
+}
+
+void beginBatchRequest(QByteArray& packet)
+{
+    // Sayı ve uzunluk finishBatchRequest'te doldurulur
+    beginPacket(packet, MessageType::BatchRequest, BatchHeaderSize);
+}
+
+bool appendBatchFrame(QByteArray& packet, int frameId, const cv::Mat& frame, Codec codec,
+                      int jpegQuality, std::vector<uchar>& encodeBuffer)
+{
+    size_t dataSize = 0;
+    if (!prepareFrameData(frame, codec, jpegQuality, encodeBuffer, dataSize)) {
+        return false;
+    }
+
+    uchar* out = growPacket(packet, FrameHeaderSize + static_cast<int>(dataSize));
+    writeFramePayload(out, frameId, frame, codec, encodeBuffer, dataSize);
+    return true;
+}
+
+void appendBatchSharedFrame(QByteArray& packet, int frameId, const cv::Mat& frame, int slot)
+{
+    uchar* out = growPacket(packet, FrameHeaderSize + 4);
+    writeFrameHeader(out, frameId, frame, Codec::SharedMemory, 4);
+    qToBigEndian<quint32>(static_cast<quint32>(slot), out + FrameHeaderSize);
+}
+
+void finishBatchRequest(QByteArray& packet, int count)
+{
+    auto* out = reinterpret_cast<uchar*>(packet.data());
+    qToBigEndian<quint32>(static_cast<quint32>(packet.size() - 4), out);
+    qToBigEndian<quint16>(static_cast<quint16>(count), out + 4 + HeaderSize);
+    qToBigEndian<quint16>(0, out + 4 + HeaderSize + 2);
+}
+
+void encodeShmAttach(const QString& name, int slotCount, quint32 slotSize, QByteArray& packet)
+{
+    const QByteArray encodedName = name.toUtf8().left(255);
+    uchar* out = beginPacket(packet, MessageType::ShmAttach, 8 + encodedName.size());
+    qToBigEndian<quint16>(static_cast<quint16>(slotCount), out);
+    out[2] = static_cast<quint8>(encodedName.size());
+    out[3] = 0;
+    qToBigEndian<quint32>(slotSize, out + 4);
+    std::memcpy(out + 8, encodedName.constData(), encodedName.size());
+}
+
+bool decodeShmAttachAck(const QByteArray& body, bool& attached)
+{
+    if (peekType(body) != MessageType::ShmAttachAck || body.size() < HeaderSize + 4) {
+        return false;
+    }
+    attached = body.at(HeaderSize) == 1;
+    return true;
+}
+
+int peekResultFrameId(const QByteArray& body)
+{
+    if (peekType(body) != MessageType::DetectionResult ||
+        body.size() < HeaderSize + ResultHeaderSize) {
+        return -1;
+    }
+    return qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(body.constData()) + HeaderSize);
+}
+
+bool decodeDetectionResult(const QByteArray& body, const QVector<QString>& classNames,
+                           DetectionResult& result)
+{
+    if (peekType(body) != MessageType::DetectionResult ||
+        body.size() < HeaderSize + ResultHeaderSize) {
+        return false;
+    }
+
+    const auto* data = reinterpret_cast<const uchar*>(body.constData()) + HeaderSize;
+    const int count = qFromBigEndian<quint16>(data + 8);
+    if (body.size() < HeaderSize + ResultHeaderSize + count * DetectionRecordSize) {
+        return false;
+    }
+
+    result.frameId = qFromBigEndian<qint32>(data);
+    result.processingTimeMs = readFloat(data + 4);
+    result.success = (qFromBigEndian<quint16>(data + 10) & ResultFailed) == 0;
+    result.detections.clear();
+    result.detections.reserve(count);
+
+    const uchar* record = data + ResultHeaderSize;
+    for (int i = 0; i < count; ++i, record += DetectionRecordSize) {
+        Detection detection;
+        detection.classId = qFromBigEndian<quint16>(record);
+        detection.className = detection.classId < classNames.size()
+                                  ? classNames[detection.classId]
+                                  : QString::number(detection.classId);
+        detection.confidence = readFloat(record + 4);
+
+        const int x1 = qFromBigEndian<qint16>(record + 8);
+        const int y1 = qFromBigEndian<qint16>(record + 10);
+        const int x2 = qFromBigEndian<qint16>(record + 12);
+        const int y2 = qFromBigEndian<qint16>(record + 14);
+        detection.bbox = cv::Rect(x1, y1, x2 - x1, y2 - y1);
+
+        if (detection.isValid()) {
+            result.detections.append(detection);
+        }
+    }
+    return true;
+}
+
+bool decodeHello(const QByteArray& body, HelloInfo& hello)
+{
+    if (peekType(body) != MessageType::Hello || body.size() < HeaderSize + 4) {
+        return false;
+    }
+
+    const auto* data = reinterpret_cast<const uchar*>(body.constData());
+    const auto* end = data + body.size();
+    data += HeaderSize;
+
+    hello.inputSize = qFromBigEndian<quint16>(data);
+    const int classCount = qFromBigEndian<quint16>(data + 2);
+    data += 4;
+
+    hello.classNames.clear();
+    hello.classNames.reserve(classCount);
+    for (int i = 0; i < classCount && data < end; ++i) {
+        const int length = *data++;
+        if (data + length > end) {
+            return false;
+        }
+        hello.classNames.append(QString::fromUtf8(reinterpret_cast<const char*>(data), length));
+        data += length;
+    }
+    return true;
+}
+
+} // namespace WireProtocol
@@ -0,0 +1,114 @@
+#ifndef WIREPROTOCOL_H
+#define WIREPROTOCOL_H
+
+#include "ai/DetectionData.h"
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/*
+ C++ ile Python YOLO servisi arasındaki binary mesaj formatı
+ Socket üzerindeki 4 byte'lık (big-endian) uzunluk prefix'i aynı kalır,
+ sadece gövde JSON yerine sabit başlıklı binary veri olur.
+ Tüm çok byte'lı alanlar big-endian'dır. Python tarafı: python/wire_protocol.py
+
+ Ortak başlık (8 byte):
+   magic "MDPB" | version u8 | type u8 | reserved u16
+
+ FrameRequest gövdesi (16 byte + piksel verisi):
+   frame_id i32 | width u16 | height u16 | pixel_format u8 | codec u8 |
+   reserved u16 | data_size u32 | data[data_size]
+
+ DetectionResult gövdesi (12 byte + count * 16 byte):
+   frame_id i32 | processing_time_ms f32 | count u16 | flags u16 |
+   count x (class_id u16 | reserved u16 | confidence f32 | x1 i16 | y1 i16 | x2 i16 | y2 i16)
+ flags ResultFailed: servis frame'i çözemedi, istek tespitsiz (success = false) kapanır.
+
+ Hello gövdesi (servis bağlantı kurulunca bir kez gönderir):
+   input_size u16 | class_count u16 | class_count x (len u8 | utf8 ad)
+
+ ShmAttach gövdesi (C++ shared memory halkasını bildirir, SharedFrameRing.h):
+   slot_count u16 | name_len u8 | reserved u8 | slot_size u32 | name[name_len]
+ ShmAttachAck gövdesi: status u8 (1 = bağlandı) | reserved u8 x3
+
+ Codec SharedMemory olan FrameRequest'lerde data 4 byte'lık slot indeksidir (u32).
+
+ BatchRequest gövdesi (servis frame'leri tek batch olarak modele verir):
+   count u16 | reserved u16 | count x (FrameRequest gövdesi, 16 byte başlık + data)
+ Cevap olarak her frame için ayrı bir DetectionResult gönderilir.
+ */
+namespace WireProtocol {
+
+constexpr char Magic[4] = {'M', 'D', 'P', 'B'};
+constexpr quint8 Version = 1;
+
+constexpr int HeaderSize = 8;
+constexpr int FrameHeaderSize = 16;
+constexpr int ResultHeaderSize = 12;
+constexpr int DetectionRecordSize = 16;
+constexpr int BatchHeaderSize = 4;
+
+constexpr quint16 ResultFailed = 0x0001;
+
+enum class MessageType : quint8 {
+    Invalid = 0,
+    FrameRequest = 1,
+    DetectionResult = 2,
+    Hello = 3,
+    Error = 4,
+    ShmAttach = 5,
+    ShmAttachAck = 6,
+    BatchRequest = 7
+};
+
+enum class PixelFormat : quint8 {
+    BGR8 = 1,
+    Gray8 = 2
+};
+
+enum class Codec : quint8 {
+    Raw = 0,    // Sıkıştırılmamış satırlar, encode maliyeti yok (yerel bağlantı için)
+    Jpeg = 1,   // Ağ üzerinden gönderim için daha az byte
+    SharedMemory = 2 // Pikseller shared memory slot'unda, mesajda sadece slot indeksi
+};
+
+// Servisin bağlantı başında bildirdiği model bilgileri
+struct HelloInfo {
+    int inputSize = 0;              // Modelin giriş boyutu (örn. 640)
+    QVector<QString> classNames;    // class_id -> ad tablosu
+};
+
+// Gövdenin binary protokole ait olup olmadığını ve tipini döndürür
+MessageType peekType(const QByteArray& body);
+
+// Frame'i uzunluk prefix'i dahil tek bir pakete yazar. packet ve encodeBuffer
+// çağrılar arasında tekrar kullanılır, böylece her frame için ayırma yapılmaz.
+bool encodeFrameRequest(int frameId, const cv::Mat& frame, Codec codec, int jpegQuality,
+                        QByteArray& packet, std::vector<uchar>& encodeBuffer);
+
+// Pikselleri shared memory slot'una yazılmış frame için istek paketi
+void encodeSharedFrameRequest(int frameId, const cv::Mat& frame, int slot, QByteArray& packet);
+
+// Toplu istek: beginBatchRequest ile başlanır, her frame append ile eklenir,
+// finishBatchRequest uzunluk prefix'ini ve frame sayısını yazar.
+void beginBatchRequest(QByteArray& packet);
+bool appendBatchFrame(QByteArray& packet, int frameId, const cv::Mat& frame, Codec codec,
+                      int jpegQuality, std::vector<uchar>& encodeBuffer);
+void appendBatchSharedFrame(QByteArray& packet, int frameId, const cv::Mat& frame, int slot);
+void finishBatchRequest(QByteArray& packet, int count);
+
+void encodeShmAttach(const QString& name, int slotCount, quint32 slotSize, QByteArray& packet);
+bool decodeShmAttachAck(const QByteArray& body, bool& attached);
+
+// DetectionResult gövdesini çözmeden frame_id'yi okur, geçersizse -1
+int peekResultFrameId(const QByteArray& body);
+bool decodeDetectionResult(const QByteArray& body, const QVector<QString>& classNames,
+                           DetectionResult& result);
+
+bool decodeHello(const QByteArray& body, HelloInfo& hello);
+
+} // namespace WireProtocol
+
+#endif // WIREPROTOCOL_H
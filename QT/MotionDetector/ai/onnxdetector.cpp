@@ -0,0 +1,269 @@
+#include "onnxdetector.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+namespace {
+
+// Model yanında .names dosyası yoksa kullanılan COCO sınıf adları
+const char* const CocoClassNames[] = {
+    "person", "bicycle", "car", "motorcycle", "airplane", "bus", "train", "truck", "boat",
+    "traffic light", "fire hydrant", "stop sign", "parking meter", "bench", "bird", "cat",
+    "dog", "horse", "sheep", "cow", "elephant", "bear", "zebra", "giraffe", "backpack",
+    "umbrella", "handbag", "tie", "suitcase", "frisbee", "skis", "snowboard", "sports ball",
+    "kite", "baseball bat", "baseball glove", "skateboard", "surfboard", "tennis racket",
+    "bottle", "wine glass", "cup", "fork", "knife", "spoon", "bowl", "banana", "apple",
+    "sandwich", "orange", "broccoli", "carrot", "hot dog", "pizza", "donut", "cake", "chair",
+    "couch", "potted plant", "bed", "dining table", "toilet", "tv", "laptop", "mouse",
+    "remote", "keyboard", "cell phone", "microwave", "oven", "toaster", "sink",
+    "refrigerator", "book", "clock", "vase", "scissors", "teddy bear", "hair drier",
+    "toothbrush"
+};
+
+} // namespace
+
+OnnxDetector::OnnxDetector(FrameQueue* detectionQueue, const QString& modelPath, QObject *parent)
+    : InferenceBackend(detectionQueue, parent),
+    modelPath(modelPath),
+    modelLoaded(false),
+    inputSize(640),
+    confidenceThreshold(0.3f),
+    nmsThreshold(0.45f),
+    framesProcessed(0),
+    errors(0),
+    averageInferenceMs(0.0)
+{
+    qDebug() << "OnnxDetector: Worker oluşturuldu, model:" << modelPath;
+}
+
+OnnxDetector::~OnnxDetector()
+{
+    qDebug() << "OnnxDetector: Worker silindi.";
+}
+
+void OnnxDetector::setInputSize(int size)
+{
+    inputSize = qMax(32, size);
+}
+
+void OnnxDetector::setConfidenceThreshold(float threshold)
+{
+    confidenceThreshold = threshold;
+}
+
+void OnnxDetector::setNmsThreshold(float threshold)
+{
+    nmsThreshold = threshold;
+}
+
+bool OnnxDetector::loadModel()
+{
+    try {
+        net = cv::dnn::readNetFromONNX(modelPath.toStdString());
+        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+        modelLoaded = !net.empty();
+    } catch (const cv::Exception& e) {
+        qDebug() << "OnnxDetector: Model yüklenemedi:" << e.what();
+        modelLoaded = false;
+    }
+
+    if (modelLoaded) {
+        loadClassNames();
+        qDebug() << "OnnxDetector: Model yüklendi, sınıf sayısı:" << classNames.size();
+    }
+    return modelLoaded;
+}
+
+void OnnxDetector::loadClassNames()
+{
+    classNames.clear();
+
+    // yolov8n.onnx -> yolov8n.names (her satırda bir sınıf adı)
+    const QFileInfo info(modelPath);
+    QFile namesFile(info.absolutePath() + "/" + info.completeBaseName() + ".names");
+    if (namesFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream stream(&namesFile);
+        while (!stream.atEnd()) {
+            const QString line = stream.readLine().trimmed();
+            if (!line.isEmpty()) {
+                classNames.append(line);
+            }
+        }
+    }
+
+    if (classNames.isEmpty()) {
+        for (const char* name : CocoClassNames) {
+            classNames.append(QString::fromLatin1(name));
+        }
+    }
+}
+
+QString OnnxDetector::classNameFor(int classId) const
+{
+    return classId >= 0 && classId < classNames.size() ? classNames[classId]
+                                                       : QString::number(classId);
+}
+
+void OnnxDetector::startProcessing()
+{
+    if (!modelLoaded && !loadModel()) {
+        errors++;
+        emit errorOccurred(QString("ONNX model yüklenemedi: %1").arg(modelPath));
+        emit connectionStatusChanged(false);
+        return;
+    }
+
+    isRunning = true;
+    emit connectionStatusChanged(true);
+    qDebug() << "ONNX Thread: İşlem döngüsü başladı.";
+
+    while (isRunning) {
+        FrameData frameData;
+        if (!detectionQueue->pop_for(frameData, std::chrono::milliseconds(100))) {
+            continue;
+        }
+        if (!isRunning) break;
+
+        DetectionResult result = detect(frameData);
+        if (result.isValid()) {
+            emit detectionReceived(result);
+        }
+    }
+
+    emit connectionStatusChanged(false);
+    qDebug() << "ONNX Thread: İşlem döngüsü durdu.";
+}
+
+DetectionResult OnnxDetector::detect(const FrameData& frameData)
+{
+    DetectionResult result;
+    result.frameId = frameData.frameId;
+    result.streamId = frameData.streamId;
+    if (!modelLoaded || frameData.frame.empty()) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    try {
+        const Letterbox::Info info = Letterbox::apply(frameData.frame, letterboxed, inputSize);
+        cv::dnn::blobFromImage(letterboxed, blob, 1.0 / 255.0, cv::Size(), cv::Scalar(),
+                               true /* BGR -> RGB */, false);
+        net.setInput(blob);
+        net.forward(outputs, net.getUnconnectedOutLayersNames());
+
+        if (!outputs.empty()) {
+            decodeOutput(outputs[0], info, result);
+        }
+        result.success = true;
+    } catch (const cv::Exception& e) {
+        errors++;
+        qDebug() << "OnnxDetector: Inference hatası:" << e.what();
+        emit errorOccurred(QString("ONNX inference hatası: %1").arg(e.what()));
+        return result;
+    }
+
+    result.processingTimeMs = timer.nsecsElapsed() / 1.0e6;
+    result.roundTripMs = result.processingTimeMs;
+
+    // Ortalama yalnızca inference thread'inde güncellenir
+    const int processed = ++framesProcessed;
+    const double average = averageInferenceMs.load();
+    averageInferenceMs = average + (result.processingTimeMs - average) / processed;
+    return result;
+}
+
+void OnnxDetector::decodeOutput(const cv::Mat& output, const Letterbox::Info& info, DetectionResult& result)
+{
+    if (output.dims != 3) {
+        return;
+    }
+
+    // [1, A, B] -> satır başına bir aday olacak şekilde 2D görünüm
+    const int dimA = output.size[1];
+    const int dimB = output.size[2];
+    cv::Mat raw(dimA, dimB, CV_32F, const_cast<uchar*>(output.ptr()));
+
+    // YOLOv8/v11 çıkışı [özellik, aday] şeklinde gelir, adaylar satır olacak şekilde çevir
+    const bool transposed = dimA < dimB;
+    cv::Mat candidates = raw;
+    if (transposed) {
+        cv::transpose(raw, transposedOutput);
+        candidates = transposedOutput;
+    }
+    const int featureCount = candidates.cols;
+
+    // YOLOv5: 5 + sınıf (objectness var), YOLOv8: 4 + sınıf
+    const bool hasObjectness = !transposed && featureCount == classNames.size() + 5;
+    const int classOffset = hasObjectness ? 5 : 4;
+    if (featureCount <= classOffset) {
+        return;
+    }
+
+    candidateBoxes.clear();
+    candidateScores.clear();
+    candidateClasses.clear();
+
+    for (int i = 0; i < candidates.rows; ++i) {
+        const float* row = candidates.ptr<float>(i);
+        const float objectness = hasObjectness ? row[4] : 1.0f;
+        if (objectness < confidenceThreshold) continue;
+
+        const float* scores = row + classOffset;
+        const int scoreCount = featureCount - classOffset;
+        int bestClass = 0;
+        float bestScore = scores[0];
+        for (int c = 1; c < scoreCount; ++c) {
+            if (scores[c] > bestScore) {
+                bestScore = scores[c];
+                bestClass = c;
+            }
+        }
+
+        const float confidence = bestScore * objectness;
+        if (confidence < confidenceThreshold) continue;
+
+        const float cx = row[0], cy = row[1], w = row[2], h = row[3];
+        const cv::Rect box = Letterbox::toSource(info, cx - w / 2, cy - h / 2, cx + w / 2, cy + h / 2);
+        if (box.width <= 0 || box.height <= 0) continue;
+
+        candidateBoxes.push_back(box);
+        candidateScores.push_back(confidence);
+        candidateClasses.push_back(bestClass);
+    }
+
+    // Sınıf bazlı NMS: kutuları sınıfa göre kaydırarak farklı sınıfların
+    // birbirini bastırması engellenir
+    const int classStride = info.sourceSize.width + info.sourceSize.height;
+    nmsBoxes.resize(candidateBoxes.size());
+    for (size_t i = 0; i < candidateBoxes.size(); ++i) {
+        nmsBoxes[i] = candidateBoxes[i] + cv::Point(candidateClasses[i] * classStride, 0);
+    }
+    keptIndices.clear();
+    cv::dnn::NMSBoxes(nmsBoxes, candidateScores, confidenceThreshold, nmsThreshold, keptIndices);
+
+    result.detections.reserve(static_cast<int>(keptIndices.size()));
+    for (int index : keptIndices) {
+        Detection detection;
+        detection.classId = candidateClasses[index];
+        detection.className = classNameFor(detection.classId);
+        detection.confidence = candidateScores[index];
+        detection.bbox = candidateBoxes[index];
+        if (detection.isValid()) {
+            result.detections.append(detection);
+        }
+    }
+}
+
+QString OnnxDetector::getStatus() const
+{
+    return QString("ONNX[Loaded:%1, Frames:%2, AvgTime:%3ms, Errors:%4]")
+        .arg(modelLoaded ? "Yes" : "No")
+        .arg(framesProcessed.load())
+        .arg(averageInferenceMs.load(), 0, 'f', 1)
+        .arg(errors.load());
+}
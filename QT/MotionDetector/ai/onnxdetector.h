@@ -0,0 +1,74 @@
+#ifndef ONNXDETECTOR_H
+#define ONNXDETECTOR_H
+
+#include "ai/InferenceBackend.h"
+#include "ai/Letterbox.h"
+#include "core/FrameData.h"
+#include <QVector>
+#include <opencv2/dnn.hpp>
+#include <atomic>
+
+/*
+ Süreç içi (in-process) ONNX tespit backend'i
+ Model OpenCV DNN ile CPU üzerinde çalıştırılır, Python servisine ve TCP
+ gecikmesine gerek kalmaz. Letterbox ön işleme ve NMS son işleme C++'da yapılır,
+ sonuç YOLOCommunicator ile aynı DetectionResult formatındadır.
+
+ Desteklenen çıkış formatları:
+   YOLOv8/v11: [1, 4 + sınıf, N]  (cx, cy, w, h, sınıf skorları)
+   YOLOv5:     [1, N, 5 + sınıf]  (cx, cy, w, h, objectness, sınıf skorları)
+ */
+class OnnxDetector : public InferenceBackend
+{
+    Q_OBJECT
+
+public:
+    explicit OnnxDetector(FrameQueue* detectionQueue, const QString& modelPath, QObject *parent = nullptr);
+    ~OnnxDetector();
+
+    QString backendName() const override { return "ONNX (OpenCV DNN, CPU)"; }
+    QString getStatus() const override;
+
+    void setInputSize(int size);
+    void setConfidenceThreshold(float threshold);
+    void setNmsThreshold(float threshold);
+
+    // Tek frame üzerinde senkron tespit (worker döngüsü de bunu kullanır)
+    DetectionResult detect(const FrameData& frameData);
+
+public slots:
+    void startProcessing() override;
+
+private:
+    bool loadModel();
+    void loadClassNames();
+    void decodeOutput(const cv::Mat& output, const Letterbox::Info& info, DetectionResult& result);
+    QString classNameFor(int classId) const;
+
+    QString modelPath;
+    cv::dnn::Net net;
+    bool modelLoaded;
+
+    int inputSize;
+    float confidenceThreshold;
+    float nmsThreshold;
+    QVector<QString> classNames;
+
+    // Her frame için tekrar kullanılan buffer'lar
+    cv::Mat letterboxed;
+    cv::Mat blob;
+    std::vector<cv::Mat> outputs;
+    cv::Mat transposedOutput;
+    std::vector<cv::Rect> candidateBoxes;
+    std::vector<cv::Rect> nmsBoxes;
+    std::vector<float> candidateScores;
+    std::vector<int> candidateClasses;
+    std::vector<int> keptIndices;
+
+    // İstatistikler (getStatus ana thread'den okur)
+    std::atomic<int> framesProcessed;
+    std::atomic<int> errors;
+    std::atomic<double> averageInferenceMs;
+};
+
+#endif // ONNXDETECTOR_H
@@ -1,29 +1,50 @@
 #include "yolocommunicator.h"
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QDataStream>
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QtEndian>
 #include <QNetworkProxy>
 
+namespace {
+constexpr int RetryIntervalMs = 5000;     // Bağlanamayan uç nokta bu aralıkla tekrar denenir
+constexpr int ConnectTimeoutMs = 3000;
+constexpr int PoolConnectTimeoutMs = 500; // Diğer uç noktalar çalışırken onları uzun bekletmez
+constexpr int StatsIntervalMs = 500;
+constexpr double RttSmoothing = 0.1;
+constexpr size_t MaxSharedRingBytes = 256u * 1024 * 1024; // Uç nokta başına /dev/shm kullanımı
+}
+
 YOLOCommunicator::YOLOCommunicator(FrameQueue* detectionQueue, QObject *parent)
-    : QObject(parent),
-    socket(nullptr),
-    detectionQueue(detectionQueue),
-    isRunning(false),
-    connected(false),
-    serverHost("localhost"),
-    serverPort(8888),
+    : InferenceBackend(detectionQueue, parent),
+    reportedConnected(false),
+    connectedCount(0),
+    modelInputSize(0),
+    frameCodec(WireProtocol::Codec::Raw),
+    codecAuto(true),
+    jpegQuality(85),
+    maxInFlight(4),
+    requestTimeoutMs(5000),
+    inFlight(0),
+    nextSequence(0),
+    batchSize(1),
+    batchTimeoutMs(0),
+    sharedMemoryEnabled(true),
+    sharedSlotSize(0),
+    letterboxEnabled(true),
     framesSent(0),
+    batchesSent(0),
+    framesLetterboxed(0),
     resultsReceived(0),
-    errors(0)
+    errors(0),
+    bytesSent(0)
 {
+    setServerAddress("localhost", 8888);
     qDebug() << "YOLOCommunicator: Worker oluşturuldu.";
 }
 
 YOLOCommunicator::~YOLOCommunicator()
 {
-    if (socket) {
-        delete socket;
+    for (const auto& endpoint : endpoints) {
+        delete endpoint->socket;
     }
     qDebug() << "YOLOCommunicator: Worker silindi.";
 }
@@ -37,216 +58,768 @@ void YOLOCommunicator::stopProcessing()
 
 void YOLOCommunicator::startProcessing()
 {
-    socket = new QTcpSocket();
-    connect(socket, &QTcpSocket::connected, this, &YOLOCommunicator::onConnected);
-    connect(socket, &QTcpSocket::disconnected, this, &YOLOCommunicator::onDisconnected);
+    // Socket'ler bu thread'de oluşturulur ve döngü bitince silinir,
+    // tekrar başlatıldığında öncekiler sızmaz
+    for (const auto& endpoint : endpoints) {
+        endpoint->socket = new QTcpSocket();
+    }
 
     isRunning = true;
-    qDebug() << "YOLO Thread: İşlem döngüsü başladı.";
+    statsTimer.start();
+    qDebug() << "YOLO Thread: İşlem döngüsü başladı," << endpoints.size() << "uç nokta.";
 
     while (isRunning) {
-        if (!isConnected()) {
-            if (!connectToYOLO(serverHost, serverPort)) {
-                qDebug() << "YOLO Thread: Bağlantı kurulamadı, 5 saniye sonra tekrar denenecek.";
-                QThread::msleep(5000); // 5 saniye bekle
-                continue; // Döngünün başına dön
-            }
+        // Kopan ya da hiç bağlanamamış uç noktalar diğerlerini durdurmadan denenir
+        connectEndpoints();
+        if (!anyConnected()) {
+            batchFrames.clear();
+            updateEndpointStats();
+            QThread::msleep(100);
+            continue;
         }
 
-        // Tespit kuyruğundan bir kare al (kuyruk boşsa burada bekleyecek)
-        FrameData frameData = detectionQueue->pop();
-        if (!isRunning) break;
-
-        try {
-            qDebug() << "YOLO Thread: Frame gönderiliyor:" << frameData.frameId;
-
-            QJsonObject payload;
-            payload["frame_id"] = frameData.frameId;
-            payload["data"] = frameToBase64(frameData.frame);
-            // Diğer parametreler eklenebilir...
-
-            QJsonObject message;
-            message["type"] = "frame_request";
-            message["payload"] = payload;
+        // 1) Pencerede yer olduğu sürece frame topla ve batch'ler halinde gönder.
+        //    Batch, bekleyen isteği en az olan uç noktaya gider. Hiç bekleyen
+        //    istek yoksa kuyrukta kısa süre beklenir, aksi halde beklemeden
+        //    devam edilir, böylece gelen cevaplar gecikmez.
+        while (isRunning) {
+            Endpoint* target = leastLoadedEndpoint();
+            if (!target) break; // Tüm uç noktaların penceresi dolu
+
+            const int pending = target->pendingRequests.size();
+            while (isRunning && static_cast<int>(batchFrames.size()) < batchSize &&
+                   pending + static_cast<int>(batchFrames.size()) < windowSize()) {
+                FrameData frameData;
+                bool gotFrame = false;
+                if (totalPending() > 0) {
+                    gotFrame = detectionQueue->try_pop(frameData);
+                } else if (batchFrames.empty()) {
+                    gotFrame = detectionQueue->pop_for(frameData, std::chrono::milliseconds(100));
+                } else {
+                    // Batch'i doldurmak için kalan süre kadar bekle
+                    const qint64 remainingMs = batchTimeoutMs - batchTimer.elapsed();
+                    if (remainingMs <= 0) break;
+                    gotFrame = detectionQueue->pop_for(frameData, std::chrono::milliseconds(remainingMs));
+                }
+                if (!gotFrame) break;
 
-            sendMessage(message);
-            framesSent++;
+                if (batchFrames.empty()) {
+                    batchTimer.start();
+                }
+                batchFrames.push_back(std::move(frameData));
+            }
 
-            // Cevabı al (receiveMessage blocking bir yapıda olmalı)
-            QJsonObject response = receiveMessage();
-            if (response.isEmpty()) {
-                // Bağlantı kopmuş olabilir
-                handleError("Python servisinden boş cevap alındı, bağlantı kopmuş olabilir.");
-                disconnectFromYOLO();
+            // Batch doluysa, bekleme süresi dolduysa ya da pencere başka frame
+            // almıyorsa gönder ve pencereyi doldurmaya devam et
+            const int pendingTotal = pending + static_cast<int>(batchFrames.size());
+            if (batchFrames.empty() ||
+                (static_cast<int>(batchFrames.size()) < batchSize &&
+                 batchTimer.elapsed() < batchTimeoutMs && pendingTotal < windowSize())) {
+                break;
+            }
+            try {
+                flushBatch(*target);
+            } catch (const std::exception& e) {
+                // Gönderilemeyen frame'ler batchFrames'te kalır, başka uç noktaya gider
+                dropEndpoint(*target, e.what());
+            }
+        }
+        inFlight = totalPending();
+        if (!isRunning) break;
+        if (inFlight == 0) continue;
+
+        // 2) Gelen veriyi oku. Tek uç noktada socket'te beklenir: pencere doluysa
+        //    cevap beklenir, değilse çok kısa bakılıp yeni frame göndermeye dönülür.
+        //    Birden fazla uç noktada her biri beklemeden yoklanır.
+        const bool single = endpoints.size() == 1;
+        const int waitMs = leastLoadedEndpoint() ? 1 : 50;
+        bool received = false;
+        for (const auto& endpoint : endpoints) {
+            if (!isConnected(*endpoint) || endpoint->pendingRequests.isEmpty()) {
                 continue;
             }
+            try {
+                received |= readIncoming(*endpoint, single ? waitMs : 0);
 
-            if (response["type"].toString() == "detection_result") {
-                DetectionResult result = parseDetectionResult(response["payload"].toObject());
-                if (result.isValid()) {
-                    resultsReceived++;
-                    emit detectionReceived(result); // Sonucu Ana Thread'e sinyal ile gönder
+                // 3) Tamamlanan tüm mesajları işle, cevaplar sıra dışı gelebilir
+                QByteArray body;
+                while (takeMessage(*endpoint, body)) {
+                    handleMessage(*endpoint, body);
                 }
+            } catch (const std::exception& e) {
+                dropEndpoint(*endpoint, e.what());
+                continue;
             }
+            expireStaleRequests(*endpoint);
         }
-        catch (const std::exception& e) {
-            handleError(QString("YOLO Thread hatası: %1").arg(e.what()));
-            disconnectFromYOLO();
+        if (!single && !received) {
+            QThread::msleep(1);
         }
+
+        inFlight = totalPending();
+        updateEndpointStats();
+    }
+
+    for (const auto& endpoint : endpoints) {
+        disconnectFromYOLO(*endpoint);
+        resetConnectionState(*endpoint);
+        delete endpoint->socket;
+        endpoint->socket = nullptr;
     }
-    disconnectFromYOLO();
+    updateConnectionStatus();
     qDebug() << "YOLO Thread: İşlem döngüsü durdu.";
 }
 
-bool YOLOCommunicator::connectToYOLO(const QString& host, int port) {
-    qDebug() << "YOLOCommunicator: Python YOLO'ya bağlanıyor..." << host << ":" << port;
+void YOLOCommunicator::connectEndpoints()
+{
+    for (const auto& endpointPtr : endpoints) {
+        Endpoint& endpoint = *endpointPtr;
+        if (isConnected(endpoint)) {
+            continue;
+        }
+        if (endpoint.connected) {
+            // Servis bağlantıyı kapattı, bekleyen istekleri düşürülür
+            dropEndpoint(endpoint, "Bağlantı koptu");
+        }
+        if (endpoint.retryTimer.isValid() && endpoint.retryTimer.elapsed() < RetryIntervalMs) {
+            continue;
+        }
+
+        endpoint.retryTimer.start();
+        resetConnectionState(endpoint);
+        if (!connectToYOLO(endpoint, anyConnected() ? PoolConnectTimeoutMs : ConnectTimeoutMs)) {
+            qDebug() << "YOLO Thread:" << endpointName(endpoint)
+                     << "bağlantısı kurulamadı, 5 saniye sonra tekrar denenecek.";
+        }
+    }
+    updateConnectionStatus();
+}
+
+void YOLOCommunicator::dropEndpoint(Endpoint& endpoint, const QString& reason)
+{
+    handleError(QString("%1: %2").arg(endpointName(endpoint), reason));
+    endpoint.errors++;
+    disconnectFromYOLO(endpoint);
+    resetConnectionState(endpoint);
+    endpoint.retryTimer.invalidate(); // Servis yeniden başlatıldıysa hemen bağlanılır
+    updateConnectionStatus();
+}
 
-    if (isConnected()) {
+YOLOCommunicator::Endpoint* YOLOCommunicator::leastLoadedEndpoint()
+{
+    // Bekleyen isteği en az olan bağlı uç nokta, eşitlikte daha hızlı cevap veren
+    Endpoint* best = nullptr;
+    for (const auto& endpoint : endpoints) {
+        if (!isConnected(*endpoint) || endpoint->pendingRequests.size() >= windowSize()) {
+            continue;
+        }
+        if (!best || endpoint->pendingRequests.size() < best->pendingRequests.size() ||
+            (endpoint->pendingRequests.size() == best->pendingRequests.size() &&
+             endpoint->averageRttMs < best->averageRttMs)) {
+            best = endpoint.get();
+        }
+    }
+    return best;
+}
+
+int YOLOCommunicator::totalPending() const
+{
+    int total = 0;
+    for (const auto& endpoint : endpoints) {
+        total += endpoint->pendingRequests.size();
+    }
+    return total;
+}
+
+bool YOLOCommunicator::connectToYOLO(Endpoint& endpoint, int timeoutMs) {
+    qDebug() << "YOLOCommunicator: Python YOLO'ya bağlanıyor..." << endpointName(endpoint);
+
+    if (isConnected(endpoint)) {
         return true;
     }
 
-    serverHost = host;
-    serverPort = port;
+    QTcpSocket* socket = endpoint.socket;
     socket->setProxy(QNetworkProxy::NoProxy);
 
     // Asenkron bağlantı başlat
-    socket->connectToHost(host, port);
+    socket->connectToHost(endpoint.host, endpoint.port);
 
     // Gerçek bağlantı kontrolü
-    bool success = socket->waitForConnected(3000);
+    bool success = socket->waitForConnected(timeoutMs);
 
     if (!success) {
-        QString error = QString("Bağlantı başarısız: %1").arg(socket->errorString());
+        QString error = QString("%1 bağlantısı başarısız: %2").arg(endpointName(endpoint), socket->errorString());
         qDebug() << "YOLOCommunicator:" << error;
         handleError(error);
+        socket->abort();
+        return false;
     }
 
-    return success;
+    const bool isLocal = endpoint.host == "localhost" || QHostAddress(endpoint.host).isLoopback();
+    // Aynı makinedeki servise sıkıştırmadan göndermek encode maliyetini ortadan kaldırır
+    endpoint.frameCodec = codecAuto ? (isLocal ? WireProtocol::Codec::Raw : WireProtocol::Codec::Jpeg)
+                                    : frameCodec;
+    readHello(endpoint);
+
+    if (isLocal && sharedMemoryEnabled) {
+        attachSharedMemory(endpoint);
+    }
+
+    endpoint.connected = true;
+    if (endpoint.everConnected) {
+        endpoint.reconnects++;
+    }
+    endpoint.everConnected = true;
+    qDebug() << "YOLOCommunicator: Python YOLO'ya bağlandı!" << endpointName(endpoint);
+    return true;
 }
 
 
-bool YOLOCommunicator::isConnected() const
+bool YOLOCommunicator::isConnected(const Endpoint& endpoint) const
 {
-    return connected && socket && socket->state() == QTcpSocket::ConnectedState;
+    return endpoint.connected && endpoint.socket && endpoint.socket->state() == QTcpSocket::ConnectedState;
 }
 
-void YOLOCommunicator::onDisconnected() {
-    connected = false;
-    qDebug() << "YOLOCommunicator: Python YOLO bağlantısı kesildi.";
-    emit connectionStatusChanged(false);
+bool YOLOCommunicator::anyConnected() const
+{
+    for (const auto& endpoint : endpoints) {
+        if (isConnected(*endpoint)) {
+            return true;
+        }
+    }
+    return false;
 }
 
-void YOLOCommunicator::sendMessage(const QJsonObject& message)
+void YOLOCommunicator::updateConnectionStatus()
 {
-    if (!isConnected()) {
-        throw std::runtime_error("Bağlantı yok");
+    int count = 0;
+    for (const auto& endpoint : endpoints) {
+        count += isConnected(*endpoint) ? 1 : 0;
     }
+    connectedCount = count;
 
-    // JSON'a çevir
-    QJsonDocument doc(message);
-    QByteArray jsonData = doc.toJson(QJsonDocument::Compact);
+    // Arayüz için en az bir uç nokta bağlıysa backend bağlı sayılır
+    if ((count > 0) != reportedConnected) {
+        reportedConnected = count > 0;
+        qDebug() << "YOLOCommunicator: Bağlantı durumu:" << (reportedConnected ? "bağlı" : "kesildi");
+        emit connectionStatusChanged(reportedConnected);
+    }
+}
 
-    // Boyut prefix + JSON gönder
-    QByteArray packet;
-    QDataStream stream(&packet, QIODevice::WriteOnly);
-    stream.setByteOrder(QDataStream::BigEndian);
-    stream << static_cast<quint32>(jsonData.size());
-    packet.append(jsonData);
+const cv::Mat& YOLOCommunicator::prepareFrame(const Endpoint& endpoint, const cv::Mat& frame,
+                                              Letterbox::Info& info)
+{
+    // Model girişinden büyük frame'in fazla pikselleri encode edilip gönderilse de
+    // serviste yine küçültülür. Küçük frame'ler olduğu gibi gider (büyütmenin faydası yok).
+    const int inputSize = endpoint.modelInfo.inputSize;
+    if (!letterboxEnabled || inputSize <= 0 || frame.empty() ||
+        (frame.cols <= inputSize && frame.rows <= inputSize)) {
+        info = Letterbox::Info();
+        return frame;
+    }
+    info = Letterbox::apply(frame, letterboxed, inputSize);
+    framesLetterboxed++;
+    return letterboxed;
+}
 
-    // Gönder
-    qint64 written = socket->write(packet);
-    if (written != packet.size()) {
-        throw std::runtime_error("Tüm veri gönderilemedi");
+bool YOLOCommunicator::sendFrame(Endpoint& endpoint, const cv::Mat& frame, int requestId, int& slot)
+{
+    if (!isConnected(endpoint)) {
+        throw std::runtime_error("Bağlantı yok");
     }
 
-    socket->flush();
+    // Pikseller slot'a kopyalanır, socket'ten sadece küçük bir başlık geçer.
+    // Slot yoksa ya da frame sığmıyorsa normal yoldan gönderilir: uzunluk prefix'i +
+    // başlık + piksel verisi tek pakette, buffer tekrar kullanılır
+    slot = acquireSharedSlot(endpoint, frame);
+    if (slot >= 0) {
+        WireProtocol::encodeSharedFrameRequest(requestId, frame, slot, txPacket);
+    } else if (!WireProtocol::encodeFrameRequest(requestId, frame, endpoint.frameCodec,
+                                                 jpegQuality, txPacket, encodeBuffer)) {
+        return false;
+    }
+
+    try {
+        writePacket(endpoint);
+    } catch (...) {
+        endpoint.sharedRing.releaseSlot(slot);
+        slot = -1;
+        throw;
+    }
+    return true;
 }
 
-QJsonObject YOLOCommunicator::receiveMessage()
+void YOLOCommunicator::flushBatch(Endpoint& endpoint)
 {
-    if (!socket->waitForReadyRead(5000)) { // 5 saniye timeout
-        throw std::runtime_error("Cevap alma zaman aşımına uğradı.");
+    if (batchFrames.size() == 1) {
+        // Tek frame normal FrameRequest ile gider, batch desteklemeyen servislerle de uyumlu
+        const FrameData& frameData = batchFrames.front();
+        Letterbox::Info info;
+        const cv::Mat& frame = prepareFrame(endpoint, frameData.frame, info);
+        int slot = -1;
+        if (sendFrame(endpoint, frame, endpoint.nextRequestId, slot)) {
+            trackRequest(endpoint, frameData, slot, info);
+            framesSent++;
+            endpoint.framesSent++;
+        } else {
+            handleError(QString("Frame %1 encode edilemedi").arg(frameData.frameId));
+        }
+        batchFrames.clear();
+        return;
     }
 
-    QByteArray sizeData = socket->read(4);
-    QDataStream sizeStream(sizeData);
-    sizeStream.setByteOrder(QDataStream::BigEndian);
-    quint32 messageSize;
-    sizeStream >> messageSize;
+    if (!isConnected(endpoint)) {
+        throw std::runtime_error("Bağlantı yok");
+    }
+
+    // Tüm frame'ler tek pakette, servis hepsini tek model çağrısında işler.
+    // İstekler paket yazıldıktan sonra kaydedilir: yazma başarısız olursa
+    // frame'ler batchFrames'te kalır ve başka uç noktaya gönderilir
+    struct Staged {
+        const FrameData* frameData;
+        int slot;
+        Letterbox::Info info;
+    };
+    std::vector<Staged> staged;
+    staged.reserve(batchFrames.size());
+
+    WireProtocol::beginBatchRequest(txPacket);
+    for (const FrameData& frameData : batchFrames) {
+        // Kimlikler trackRequest'in tüketeceği sırayla verilir
+        const int requestId = (endpoint.nextRequestId + static_cast<int>(staged.size())) & 0x7fffffff;
+        // Letterbox buffer'ı paylaşılır, frame pakete/slot'a yazıldıktan sonra tekrar kullanılır
+        Letterbox::Info info;
+        const cv::Mat& frame = prepareFrame(endpoint, frameData.frame, info);
+        const int slot = acquireSharedSlot(endpoint, frame);
+        if (slot >= 0) {
+            WireProtocol::appendBatchSharedFrame(txPacket, requestId, frame, slot);
+        } else if (!WireProtocol::appendBatchFrame(txPacket, requestId, frame,
+                                                   endpoint.frameCodec, jpegQuality, encodeBuffer)) {
+            handleError(QString("Frame %1 encode edilemedi").arg(frameData.frameId));
+            continue;
+        }
+        staged.push_back({&frameData, slot, info});
+    }
 
-    // JSON mesajının tamamı geldi mi?
-    if (socket->bytesAvailable() < messageSize) {
-        return QJsonObject();
+    const int count = static_cast<int>(staged.size());
+    if (count > 0) {
+        WireProtocol::finishBatchRequest(txPacket, count);
+        try {
+            writePacket(endpoint);
+        } catch (...) {
+            for (const Staged& request : staged) {
+                endpoint.sharedRing.releaseSlot(request.slot);
+            }
+            throw;
+        }
+        for (const Staged& request : staged) {
+            trackRequest(endpoint, *request.frameData, request.slot, request.info);
+        }
     }
+    batchFrames.clear();
 
-    // JSON'u oku
-    QByteArray jsonData = socket->read(messageSize);
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData);
+    if (count == 0) {
+        return;
+    }
+    framesSent += count;
+    endpoint.framesSent += count;
+    batchesSent++;
+}
 
-    return doc.object();
+int YOLOCommunicator::acquireSharedSlot(Endpoint& endpoint, const cv::Mat& frame)
+{
+    if (!endpoint.sharedMemoryActive) {
+        return -1;
+    }
+    const int slot = endpoint.sharedRing.acquireSlot();
+    if (slot >= 0 && endpoint.sharedRing.writeFrame(slot, frame)) {
+        return slot;
+    }
+    endpoint.sharedRing.releaseSlot(slot);
+    return -1;
 }
 
-QString YOLOCommunicator::frameToBase64(const cv::Mat& frame)
+void YOLOCommunicator::writePacket(Endpoint& endpoint)
 {
-    // Frame i JPEG e encode et
-    std::vector<uchar> buffer;
-    std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, 95}; // Yüksek kalite
-    cv::imencode(".jpg", frame, buffer, params);
+    qint64 written = endpoint.socket->write(txPacket);
+    if (written != txPacket.size()) {
+        throw std::runtime_error("Tüm veri gönderilemedi");
+    }
+    bytesSent += static_cast<quint64>(written);
 
-    // Base64'e çevir
-    QByteArray byteArray(reinterpret_cast<const char*>(buffer.data()), buffer.size());
-    return byteArray.toBase64();
+    endpoint.socket->flush();
 }
 
-DetectionResult YOLOCommunicator::parseDetectionResult(const QJsonObject& json)
+void YOLOCommunicator::trackRequest(Endpoint& endpoint, const FrameData& frameData, int slot,
+                                    const Letterbox::Info& info)
 {
-    DetectionResult result;
+    // İstek pakete nextRequestId kimliği ile yazıldı, kimlik burada tüketilir
+    PendingRequest request;
+    request.frameId = frameData.frameId;
+    request.streamId = frameData.streamId;
+    request.sequence = nextSequence++;
+    request.sentTimer.start();
+    request.slot = slot;
+    request.letterbox = info;
+    endpoint.pendingRequests.insert(endpoint.nextRequestId, request);
+    endpoint.nextRequestId = (endpoint.nextRequestId + 1) & 0x7fffffff; // frame_id alanı i32
+
+    completions.emplace(request.sequence, Completion());
+}
 
-    try {
-        result.frameId = json["frame_id"].toInt();
-        result.processingTimeMs = json["processing_time_ms"].toDouble();
-        result.success = true;
+void YOLOCommunicator::completeRequest(quint64 sequence, const DetectionResult* result)
+{
+    auto it = completions.find(sequence);
+    if (it == completions.end()) {
+        return;
+    }
+    it->second.done = true;
+    if (result) {
+        it->second.hasResult = true;
+        it->second.result = *result;
+    }
+
+    // Uç noktalar farklı hızda cevap verir. Sonuç, kendisinden önce gönderilen
+    // istekler tamamlanana (cevap, zaman aşımı ya da bağlantı kopması) kadar bekletilir.
+    while (!completions.empty() && completions.begin()->second.done) {
+        auto first = completions.begin();
+        if (first->second.hasResult) {
+            resultsReceived++;
+            emit detectionReceived(first->second.result); // Sonucu Ana Thread'e sinyal ile gönder
+        }
+        completions.erase(first);
+    }
+}
+
+int YOLOCommunicator::windowSize() const
+{
+    // Batch modunda servis bir batch'i işlerken sıradaki batch aktarılabilsin
+    return batchSize > 1 ? qMax(maxInFlight, 2 * batchSize) : maxInFlight;
+}
 
-        // Detections array'ini parse et
-        QJsonArray detectionsArray = json["detections"].toArray();
+bool YOLOCommunicator::readIncoming(Endpoint& endpoint, int timeoutMs)
+{
+    QTcpSocket* socket = endpoint.socket;
+    if (socket->bytesAvailable() == 0 && !socket->waitForReadyRead(timeoutMs)) {
+        if (socket->state() != QAbstractSocket::ConnectedState) {
+            throw std::runtime_error("Bağlantı koptu");
+        }
+        return false;
+    }
+    endpoint.rxBuffer.append(socket->readAll());
+    return true;
+}
 
-        for (const auto& detectionValue : detectionsArray) {
-            QJsonObject detectionObj = detectionValue.toObject();
+bool YOLOCommunicator::takeMessage(Endpoint& endpoint, QByteArray& body)
+{
+    // Uzunluk prefix'i ve gövdenin tamamı gelmeden mesaj çıkarılmaz,
+    // eksik kısım bir sonraki okumada tamamlanır
+    QByteArray& rxBuffer = endpoint.rxBuffer;
+    if (rxBuffer.size() < 4) {
+        return false;
+    }
+    const quint32 messageSize = qFromBigEndian<quint32>(rxBuffer.constData());
+    if (static_cast<quint32>(rxBuffer.size()) - 4 < messageSize) {
+        return false;
+    }
 
-            Detection detection;
-            detection.classId = detectionObj["class_id"].toInt();
-            detection.className = detectionObj["class_name"].toString();
-            detection.confidence = detectionObj["confidence"].toDouble();
+    body = rxBuffer.mid(4, static_cast<int>(messageSize));
+    rxBuffer.remove(0, 4 + static_cast<int>(messageSize));
+    return true;
+}
 
-            // Bounding box parse et
-            QJsonObject bboxObj = detectionObj["bbox"].toObject();
-            int x1 = bboxObj["x1"].toInt();
-            int y1 = bboxObj["y1"].toInt();
-            int x2 = bboxObj["x2"].toInt();
-            int y2 = bboxObj["y2"].toInt();
+void YOLOCommunicator::handleMessage(Endpoint& endpoint, const QByteArray& body)
+{
+    if (WireProtocol::peekType(body) != WireProtocol::MessageType::DetectionResult) {
+        return;
+    }
 
-            detection.bbox = cv::Rect(x1, y1, x2 - x1, y2 - y1);
+    // Kutuları kaynak koordinatlarına çevirmek için önce isteği bul
+    const int requestId = WireProtocol::peekResultFrameId(body);
+    auto it = endpoint.pendingRequests.find(requestId);
+    if (it == endpoint.pendingRequests.end()) {
+        // Zaman aşımına uğramış ya da bilinmeyen bir isteğin cevabı. Servis slot'la
+        // işini bitirdi, artık tekrar kullanılabilir.
+        auto expired = endpoint.expiredSlots.find(requestId);
+        if (expired != endpoint.expiredSlots.end()) {
+            endpoint.sharedRing.releaseSlot(expired.value());
+            endpoint.expiredSlots.erase(expired);
+        }
+        qDebug() << "YOLOCommunicator: Beklenmeyen cevap," << endpointName(endpoint) << "istek:" << requestId;
+        return;
+    }
+    DetectionResult result = parseDetectionResult(endpoint, body, it->letterbox);
+    result.frameId = it->frameId;
+    result.streamId = it->streamId;
+    result.roundTripMs = it->sentTimer.nsecsElapsed() / 1.0e6;
+    const quint64 sequence = it->sequence;
+    endpoint.sharedRing.releaseSlot(it->slot);
+    endpoint.pendingRequests.erase(it);
+
+    endpoint.averageRttMs = endpoint.resultsReceived == 0
+                                ? result.roundTripMs
+                                : endpoint.averageRttMs + RttSmoothing * (result.roundTripMs - endpoint.averageRttMs);
+    endpoint.resultsReceived++;
+    completeRequest(sequence, result.isValid() ? &result : nullptr);
+}
 
-            if (detection.isValid()) {
-                result.detections.append(detection);
+void YOLOCommunicator::expireStaleRequests(Endpoint& endpoint)
+{
+    for (auto it = endpoint.pendingRequests.begin(); it != endpoint.pendingRequests.end();) {
+        if (it->sentTimer.elapsed() > requestTimeoutMs) {
+            handleError(QString("Frame %1 (akış %2) için %3 cevabı zaman aşımına uğradı")
+                            .arg(it->frameId).arg(it->streamId).arg(endpointName(endpoint)));
+            endpoint.errors++;
+            if (it->slot >= 0) {
+                endpoint.expiredSlots.insert(it.key(), it->slot);
             }
+            completeRequest(it->sequence, nullptr);
+            it = endpoint.pendingRequests.erase(it);
+        } else {
+            ++it;
         }
+    }
+}
+
+void YOLOCommunicator::resetConnectionState(Endpoint& endpoint)
+{
+    // Kopan bağlantıdaki istekler ve yarım kalmış mesajlar geçersizdir.
+    // Sonuçları beklenmez, sıralamada arkalarındaki sonuçlar serbest kalır.
+    for (const PendingRequest& request : endpoint.pendingRequests) {
+        completeRequest(request.sequence, nullptr);
+    }
+    endpoint.pendingRequests.clear();
+    endpoint.expiredSlots.clear();
+    endpoint.nextRequestId = 0;
+    endpoint.rxBuffer.clear();
+    endpoint.connected = false;
+    inFlight = totalPending();
+
+    // Servis yeni bağlantıda segmente tekrar bağlanır
+    endpoint.sharedMemoryActive = false;
+    endpoint.sharedRing.destroy();
+}
 
+bool YOLOCommunicator::waitForMessage(Endpoint& endpoint, WireProtocol::MessageType type, int timeoutMs,
+                                      QByteArray& body)
+{
+    QElapsedTimer timer;
+    timer.start();
+    try {
+        while (timer.elapsed() < timeoutMs) {
+            while (takeMessage(endpoint, body)) {
+                if (WireProtocol::peekType(body) == type) {
+                    return true;
+                }
+            }
+            readIncoming(endpoint, 100);
+        }
     } catch (const std::exception& e) {
-        qDebug() << "YOLOCommunicator: Parse hatası:" << e.what();
+        qDebug() << "YOLOCommunicator: Mesaj beklenirken hata:" << e.what();
+    }
+    return false;
+}
+
+void YOLOCommunicator::attachSharedMemory(Endpoint& endpoint)
+{
+    if (!SharedFrameRing::isSupported()) {
+        qDebug() << "YOLOCommunicator: Shared memory desteklenmiyor, TCP ile devam ediliyor.";
+        return;
+    }
+
+    // Letterbox açıkken gönderilen frame'ler model girişinden büyük olmaz, slot'lar
+    // o boyuta göre ayrılır. Her bekleyen istek için bir slot yeterli, toplam boyut
+    // sınırlıdır; slot bulamayan frame TCP ile gider.
+    size_t slotSize = sharedSlotSize;
+    if (slotSize == 0) {
+        const int inputSize = endpoint.modelInfo.inputSize;
+        slotSize = letterboxEnabled && inputSize > 0 ? static_cast<size_t>(inputSize) * inputSize * 3
+                                                     : static_cast<size_t>(1920) * 1080 * 3;
+    }
+    const int slotCount = static_cast<int>(qMin(static_cast<size_t>(windowSize()),
+                                                qMax<size_t>(1, MaxSharedRingBytes / slotSize)));
+
+    // Her uç noktanın kendi segmenti vardır
+    const QString name = QString("motiondetector_%1_%2")
+                             .arg(QCoreApplication::applicationPid()).arg(endpoint.index);
+    if (!endpoint.sharedRing.create(name, slotCount, slotSize)) {
+        qDebug() << "YOLOCommunicator: Shared memory ayrılamadı, TCP ile devam ediliyor.";
+        return;
+    }
+
+    WireProtocol::encodeShmAttach(name, endpoint.sharedRing.slotCount(),
+                                  static_cast<quint32>(endpoint.sharedRing.slotSize()), txPacket);
+    endpoint.socket->write(txPacket);
+    endpoint.socket->flush();
+
+    QByteArray body;
+    bool attached = false;
+    if (waitForMessage(endpoint, WireProtocol::MessageType::ShmAttachAck, 3000, body) &&
+        WireProtocol::decodeShmAttachAck(body, attached) && attached) {
+        endpoint.sharedMemoryActive = true;
+        qDebug() << "YOLOCommunicator: Shared memory aktarımı aktif:" << name;
+        return;
+    }
+
+    // Servis eski sürüm ya da segmenti açamadı, TCP yoluna dön
+    qDebug() << "YOLOCommunicator: Servis shared memory'ye bağlanamadı, TCP ile devam ediliyor.";
+    endpoint.sharedRing.destroy();
+}
+
+void YOLOCommunicator::readHello(Endpoint& endpoint)
+{
+    // Servis bağlantı kurulunca model bilgilerini (sınıf adları, giriş boyutu) gönderir
+    QByteArray body;
+    if (waitForMessage(endpoint, WireProtocol::MessageType::Hello, 3000, body) &&
+        WireProtocol::decodeHello(body, endpoint.modelInfo)) {
+        modelInputSize = endpoint.modelInfo.inputSize;
+        qDebug() << "YOLOCommunicator: Model bilgisi alındı, sınıf sayısı:"
+                 << endpoint.modelInfo.classNames.size() << "giriş boyutu:" << endpoint.modelInfo.inputSize;
+        return;
+    }
+    qDebug() << "YOLOCommunicator: Hello mesajı alınamadı, sınıf adları numara olarak gösterilecek.";
+    endpoint.modelInfo = WireProtocol::HelloInfo();
+}
+
+DetectionResult YOLOCommunicator::parseDetectionResult(const Endpoint& endpoint, const QByteArray& body,
+                                                       const Letterbox::Info& info)
+{
+    DetectionResult result;
+    if (!WireProtocol::decodeDetectionResult(body, endpoint.modelInfo.classNames, result)) {
+        qDebug() << "YOLOCommunicator: Parse hatası, geçersiz detection mesajı";
         result.success = false;
+        return result;
     }
 
+    if (!info.isIdentity()) {
+        // Kutular letterbox'lı görüntüye göre, kaynak frame'e geri çevrilir
+        for (Detection& detection : result.detections) {
+            const cv::Rect& box = detection.bbox;
+            detection.bbox = Letterbox::toSource(info, box.x, box.y, box.x + box.width, box.y + box.height);
+        }
+    }
     return result;
 }
 
+void YOLOCommunicator::setServerAddress(const QString& host, int port)
+{
+    setEndpoints({QString("%1:%2").arg(host).arg(port)});
+}
+
+void YOLOCommunicator::setEndpoints(const QStringList& addresses)
+{
+    std::vector<std::unique_ptr<Endpoint>> parsed;
+    for (const QString& address : addresses) {
+        const QString trimmed = address.trimmed();
+        if (trimmed.isEmpty()) {
+            continue;
+        }
+        auto endpoint = std::make_unique<Endpoint>();
+        const int colon = trimmed.lastIndexOf(':');
+        endpoint->host = colon > 0 ? trimmed.left(colon) : trimmed;
+        endpoint->port = colon > 0 ? trimmed.mid(colon + 1).toInt() : 8888;
+        endpoint->index = static_cast<int>(parsed.size());
+        parsed.push_back(std::move(endpoint));
+    }
+    if (!parsed.empty()) {
+        endpoints = std::move(parsed);
+    }
+}
+
+void YOLOCommunicator::setFrameCodec(WireProtocol::Codec codec)
+{
+    frameCodec = codec;
+    codecAuto = false;
+}
+
+void YOLOCommunicator::setJpegQuality(int quality)
+{
+    jpegQuality = qBound(1, quality, 100);
+}
+
+void YOLOCommunicator::setMaxInFlight(int count)
+{
+    maxInFlight = qMax(1, count);
+}
+
+void YOLOCommunicator::setBatchSize(int size)
+{
+    batchSize = qBound(1, size, 64);
+}
+
+void YOLOCommunicator::setBatchTimeoutMs(int timeoutMs)
+{
+    batchTimeoutMs = qMax(0, timeoutMs);
+}
+
+void YOLOCommunicator::setUseSharedMemory(bool enabled)
+{
+    sharedMemoryEnabled = enabled;
+}
+
+void YOLOCommunicator::setSharedSlotSize(size_t bytes)
+{
+    sharedSlotSize = bytes;
+}
+
+void YOLOCommunicator::setLetterboxEnabled(bool enabled)
+{
+    letterboxEnabled = enabled;
+}
+
+QString YOLOCommunicator::endpointName(const Endpoint& endpoint)
+{
+    return QString("%1:%2").arg(endpoint.host).arg(endpoint.port);
+}
+
+void YOLOCommunicator::updateEndpointStats()
+{
+    if (statsTimer.elapsed() < StatsIntervalMs) {
+        return;
+    }
+    statsTimer.restart();
+
+    QStringList parts;
+    for (const auto& endpoint : endpoints) {
+        parts << QString("%1 %2%3 %4/%5 sent:%6 rtt:%7ms err:%8 rc:%9")
+                     .arg(endpointName(*endpoint))
+                     .arg(isConnected(*endpoint) ? "up" : "down")
+                     .arg(endpoint->sharedMemoryActive ? " SHM" : "")
+                     .arg(endpoint->pendingRequests.size())
+                     .arg(windowSize())
+                     .arg(endpoint->framesSent)
+                     .arg(endpoint->averageRttMs, 0, 'f', 1)
+                     .arg(endpoint->errors)
+                     .arg(endpoint->reconnects);
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    endpointStats = parts.join("; ");
+}
+
 QString YOLOCommunicator::getStatus() const
 {
-    return QString("YOLO[Connected:%1, Sent:%2, Received:%3, Errors:%4]")
-    .arg(isConnected() ? "Yes" : "No")
-        .arg(framesSent)
-        .arg(resultsReceived)
-        .arg(errors);
+    QString perEndpoint;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        perEndpoint = endpointStats;
+    }
+    const int inputSize = modelInputSize;
+    return QString("YOLO[Connected:%1/%2, InFlight:%3/%4, Batch:%5, Sent:%6, Received:%7, Errors:%8, %9MB, Letterbox:%10, Endpoints:{%11}]")
+    .arg(connectedCount.load())
+        .arg(static_cast<int>(endpoints.size()))
+        .arg(inFlight.load())
+        .arg(windowSize() * qMax(1, connectedCount.load()))
+        .arg(batchSize > 1 ? QString("%1/%2ms, %3 sent").arg(batchSize).arg(batchTimeoutMs).arg(batchesSent.load())
+                           : QString("off"))
+        .arg(framesSent.load())
+        .arg(resultsReceived.load())
+        .arg(errors.load())
+        .arg(static_cast<double>(bytesSent.load()) / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(letterboxEnabled && inputSize > 0
+                 ? QString("%1px, %2 frames").arg(inputSize).arg(framesLetterboxed.load())
+                 : QString("off"))
+        .arg(perEndpoint);
 }
 
 void YOLOCommunicator::handleError(const QString& errorMessage)
@@ -256,7 +829,8 @@ void YOLOCommunicator::handleError(const QString& errorMessage)
     emit errorOccurred(errorMessage);
 }
 
-void YOLOCommunicator::disconnectFromYOLO() {
+void YOLOCommunicator::disconnectFromYOLO(Endpoint& endpoint) {
+    QTcpSocket* socket = endpoint.socket;
     if (socket && socket->isOpen()) {
         socket->disconnectFromHost();
         // Beklemeli disconnect, thread'in blocklanmaması için isteğe bağlı
@@ -264,11 +838,8 @@ void YOLOCommunicator::disconnectFromYOLO() {
             socket->waitForDisconnected(1000);
         }
     }
-    // Zaten onDisconnected sinyali 'connected' bayrağını ve durumu yönetecek.
-}
-
-void YOLOCommunicator::onConnected() {
-    connected = true;
-    qDebug() << "YOLOCommunicator: Python YOLO'ya bağlandı!";
-    emit connectionStatusChanged(true);
+    if (endpoint.connected) {
+        qDebug() << "YOLOCommunicator: Python YOLO bağlantısı kesildi." << endpointName(endpoint);
+    }
+    endpoint.connected = false;
 }
@@ -2,16 +2,34 @@
 #define YOLOCOMMUNICATOR_H
 
 #include "ai/DetectionData.h"
+#include "ai/InferenceBackend.h"
+#include "ai/Letterbox.h"
+#include "ai/WireProtocol.h"
+#include "ai/SharedFrameRing.h"
 #include "core/FrameData.h"
 #include "core/ThreadQueue.h" // FrameQueue için
 #include <QObject>
 #include <QTcpSocket>
-#include <QJsonObject>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QStringList>
 #include <opencv2/opencv.hpp>
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
 #include <QThread>
 
-class YOLOCommunicator : public QObject
+/*
+ TCP üzerinden harici Python YOLO servisleri ile konuşan inference backend'i
+ Birden fazla servis süreci (uç nokta) verilebilir, her biri kendi bağlantısı,
+ in-flight penceresi, shared memory halkası ve istatistikleriyle yönetilir.
+ Frame'ler bekleyen isteği en az olan bağlı uç noktaya gider; kopan uç nokta
+ diğerlerini durdurmadan arka arkaya yeniden bağlanmayı dener. Sonuçlar hangi
+ uç noktadan gelirse gelsin gönderim sırasıyla (frameId sırası) yayınlanır.
+ */
+class YOLOCommunicator : public InferenceBackend
 {
     Q_OBJECT
 
@@ -19,45 +37,172 @@ public:
     explicit YOLOCommunicator(FrameQueue* detectionQueue, QObject *parent = nullptr);
     ~YOLOCommunicator();
 
-    QString getStatus() const;
+    QString backendName() const override { return "Python YOLO (TCP)"; }
+    QString getStatus() const override;
 
-public slots:
-    void startProcessing();
-    void stopProcessing();
+    // Servis adresi (varsayılan localhost:8888), startProcessing öncesinde ayarlanmalı
+    void setServerAddress(const QString& host, int port);
+    // Birden fazla servis: "host:port" listesi (port yoksa 8888). Boş liste yok sayılır.
+    // startProcessing öncesinde ayarlanmalı.
+    void setEndpoints(const QStringList& addresses);
+
+    // Frame'lerin socket üzerinden hangi codec ile gönderileceği.
+    // Ayarlanmazsa yerel bağlantıda Raw, uzak bağlantıda Jpeg seçilir.
+    void setFrameCodec(WireProtocol::Codec codec);
+    void setJpegQuality(int quality);
+
+    // Aynı anda cevabı beklenen en fazla istek sayısı (in-flight penceresi)
+    void setMaxInFlight(int count);
+
+    // Toplu gönderim: en fazla batchSize frame biriktirilir ya da ilk frame'den sonra
+    // batchTimeoutMs dolunca eldeki frame'ler tek istekte gönderilir ve servis bunları
+    // tek batch olarak modele verir. Canlı oynatmada 1 (varsayılan, ek gecikme yok),
+    // offline işlemede 8-16 frame ve birkaç on ms bekleme daha yüksek throughput verir.
+    void setBatchSize(int size);
+    void setBatchTimeoutMs(int timeoutMs);
+
+    // Yerel servis için frame'leri shared memory üzerinden gönder (varsayılan açık).
+    // Platform desteklemiyorsa veya servis bağlanamazsa TCP yoluna dönülür.
+    void setUseSharedMemory(bool enabled);
+    // 0 (varsayılan): letterbox açıksa model giriş boyutu (inputSize² x 3), değilse 1080p.
+    // Sığmayan frame'ler TCP ile gider.
+    void setSharedSlotSize(size_t bytes);
 
-signals:
-    void detectionReceived(const DetectionResult& result);
-    void connectionStatusChanged(bool connected);
-    void errorOccurred(const QString& errorMessage);
+    // Model giriş boyutundan (Hello mesajı) büyük frame'ler göndermeden önce
+    // letterbox ile küçültülür, kutular kaynak koordinatlarına geri çevrilir (varsayılan açık)
+    void setLetterboxEnabled(bool enabled);
 
-private slots:
-    void onConnected();
-    void onDisconnected();
-    // onDataReceived ve onSocketError artık doğrudan döngü içinde yönetilecek
+public slots:
+    void startProcessing() override;
+    void stopProcessing() override;
 
 private:
-    bool connectToYOLO(const QString& host = "localhost", int port = 8888);
-    void disconnectFromYOLO();
-    bool isConnected() const;
-
-    void sendMessage(const QJsonObject& message);
-    QJsonObject receiveMessage();
-    QString frameToBase64(const cv::Mat& frame);
-    DetectionResult parseDetectionResult(const QJsonObject& json);
+    // Pipeline durumu: istek kimliği ile eşleştirilen bekleyen istekler.
+    // Mesajdaki frame_id alanında bağlantı başına artan istek kimliği gider,
+    // böylece farklı akışların aynı frameId'leri çakışmaz; servis alanı aynen geri yollar.
+    struct PendingRequest {
+        int frameId = -1;
+        int streamId = 0;
+        quint64 sequence = 0;       // Gönderim sırası (sonuçlar bu sırayla yayınlanır)
+        QElapsedTimer sentTimer;    // Gönderimden bu yana geçen süre (RTT için)
+        int slot = -1;              // Shared memory slot'u (kullanılmadıysa -1)
+        Letterbox::Info letterbox;  // Gönderilen görüntü -> kaynak frame dönüşümü
+    };
+
+    // Bir servis süreci ve ona ait bağlantı durumu. Sadece YOLO thread'inden kullanılır.
+    struct Endpoint {
+        QString host;
+        int port = 8888;
+        int index = 0;
+        QTcpSocket* socket = nullptr;
+        bool connected = false;
+
+        WireProtocol::Codec frameCodec = WireProtocol::Codec::Raw;
+        WireProtocol::HelloInfo modelInfo;
+        QHash<int, PendingRequest> pendingRequests;
+        int nextRequestId = 0;
+        QByteArray rxBuffer;            // Henüz tamamlanmamış gelen veri
+
+        SharedFrameRing sharedRing;
+        bool sharedMemoryActive = false;
+        // Zaman aşımına uğrayan isteklerin slot'ları: servis hala okuyor olabilir,
+        // geç cevap gelene ya da bağlantı kapanana kadar tekrar kullanılmaz
+        QHash<int, int> expiredSlots;
+
+        QElapsedTimer retryTimer;       // Son bağlanma denemesi, geçersizse hemen denenir
+        bool everConnected = false;     // Yeniden bağlanma sayımı için
+
+        // İstatistikler
+        int framesSent = 0;
+        int resultsReceived = 0;
+        int errors = 0;
+        int reconnects = 0;
+        double averageRttMs = 0.0;      // Üstel ortalama
+    };
+
+    // Tamamlanan istek sırası gelene kadar burada bekler
+    struct Completion {
+        bool done = false;
+        bool hasResult = false;
+        DetectionResult result;
+    };
+
+    bool connectToYOLO(Endpoint& endpoint, int timeoutMs);
+    void disconnectFromYOLO(Endpoint& endpoint);
+    bool isConnected(const Endpoint& endpoint) const;
+    bool anyConnected() const;
+    void updateConnectionStatus();
+    void connectEndpoints();
+    void dropEndpoint(Endpoint& endpoint, const QString& reason);
+    Endpoint* leastLoadedEndpoint();
+    int totalPending() const;
+
+    bool sendFrame(Endpoint& endpoint, const cv::Mat& frame, int requestId, int& slot);
+    const cv::Mat& prepareFrame(const Endpoint& endpoint, const cv::Mat& frame, Letterbox::Info& info);
+    void flushBatch(Endpoint& endpoint);
+    int acquireSharedSlot(Endpoint& endpoint, const cv::Mat& frame);
+    void writePacket(Endpoint& endpoint);
+    void trackRequest(Endpoint& endpoint, const FrameData& frameData, int slot, const Letterbox::Info& info);
+    void completeRequest(quint64 sequence, const DetectionResult* result);
+    int windowSize() const;
+    bool waitForMessage(Endpoint& endpoint, WireProtocol::MessageType type, int timeoutMs, QByteArray& body);
+    void attachSharedMemory(Endpoint& endpoint);
+    bool readIncoming(Endpoint& endpoint, int timeoutMs);
+    bool takeMessage(Endpoint& endpoint, QByteArray& body);
+    void handleMessage(Endpoint& endpoint, const QByteArray& body);
+    void expireStaleRequests(Endpoint& endpoint);
+    void resetConnectionState(Endpoint& endpoint);
+    void readHello(Endpoint& endpoint);
+    DetectionResult parseDetectionResult(const Endpoint& endpoint, const QByteArray& body,
+                                         const Letterbox::Info& info);
     void handleError(const QString& errorMessage);
+    static QString endpointName(const Endpoint& endpoint);
+    void updateEndpointStats();
+
+    std::vector<std::unique_ptr<Endpoint>> endpoints;
+    bool reportedConnected;         // Son gönderilen connectionStatusChanged değeri
+    std::atomic<int> connectedCount;
+    std::atomic<int> modelInputSize; // Son Hello mesajındaki giriş boyutu (durum için)
+
+    // Binary protokol ayarları ve tekrar kullanılan buffer'lar
+    WireProtocol::Codec frameCodec;
+    bool codecAuto;
+    int jpegQuality;
+    QByteArray txPacket;
+    std::vector<uchar> encodeBuffer;
+
+    int maxInFlight;                // Uç nokta başına
+    int requestTimeoutMs;
+    std::atomic<int> inFlight;      // Tüm uç noktalarda
+
+    // Sonuçların gönderim sırasıyla yayınlanması
+    std::map<quint64, Completion> completions;
+    quint64 nextSequence;
+
+    // Toplu gönderim durumu
+    std::vector<FrameData> batchFrames;  // Henüz gönderilmemiş, biriktirilen frame'ler
+    QElapsedTimer batchTimer;           // Batch'in ilk frame'inden bu yana geçen süre
+    int batchSize;
+    int batchTimeoutMs;
 
-    QTcpSocket* socket;
-    FrameQueue* detectionQueue;
-    std::atomic<bool> isRunning;
+    // Shared memory aktarımı (halkalar uç nokta başına)
+    bool sharedMemoryEnabled;
+    size_t sharedSlotSize;
 
-    bool connected;
-    QString serverHost;
-    int serverPort;
+    // Gönderim öncesi ön işleme (buffer her frame'de tekrar kullanılır)
+    bool letterboxEnabled;
+    cv::Mat letterboxed;
 
-    // İstatistikler
-    int framesSent;
-    int resultsReceived;
-    int errors;
+    // İstatistikler (getStatus ana thread'den okur)
+    std::atomic<int> framesSent;
+    std::atomic<int> batchesSent;
+    std::atomic<int> framesLetterboxed;
+    std::atomic<int> resultsReceived;
+    std::atomic<int> errors;
+    std::atomic<quint64> bytesSent;
+    QString endpointStats;          // getStatus için, YOLO thread'inde güncellenir
+    QElapsedTimer statsTimer;
+    mutable std::mutex statsMutex;
 };
 
 #endif // YOLOCOMMUNICATOR_H
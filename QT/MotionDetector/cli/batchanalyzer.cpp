@@ -0,0 +1,288 @@
+#include "batchanalyzer.h"
+#include "ai/onnxdetector.h"
+#include "ai/yolocommunicator.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QTextStream>
+
+BatchAnalyzer::BatchAnalyzer(const BatchOptions& options, QObject *parent)
+    : QObject(parent),
+    options(options),
+    framePool(128),
+    frameQueue(64),
+    detectionQueue(32),
+    videoController(nullptr),
+    backend(nullptr),
+    exporter(nullptr),
+    hasHeldFrame(false),
+    decodeStarted(false),
+    decodeFinished(false),
+    isFinished(false),
+    framesDecoded(0),
+    framesForwarded(0),
+    resultsWritten(0),
+    detectionsWritten(0),
+    backendErrors(0)
+{
+    this->options.detectionStride = qMax(1, options.detectionStride);
+    if (this->options.outputPath.isEmpty()) {
+        const QFileInfo info(options.videoPath);
+        this->options.outputPath = info.absolutePath() + "/" + info.completeBaseName() + ".detections";
+    } else {
+        this->options.outputPath = ResultExporter::basePathFor(options.outputPath);
+    }
+    if (this->options.exportFormats == 0) {
+        this->options.exportFormats = ResultExporter::JsonLines;
+    }
+
+    videoThread.setObjectName("VideoThread");
+    backendThread.setObjectName("BackendThread");
+    exportThread.setObjectName("ExportThread");
+
+    // Event loop boşaldıkça kuyruk boşaltılır, tespit kuyruğu doluysa 1 ms sonra tekrar denenir
+    pumpTimer.setInterval(1);
+    connect(&pumpTimer, &QTimer::timeout, this, &BatchAnalyzer::pumpFrames);
+
+    connectTimer.setSingleShot(true);
+    connect(&connectTimer, &QTimer::timeout, this, &BatchAnalyzer::onConnectTimeout);
+}
+
+BatchAnalyzer::~BatchAnalyzer()
+{
+    if (videoController) videoController->stopProcessing();
+    if (backend) backend->stopProcessing();
+    videoThread.quit();
+    backendThread.quit();
+    exportThread.quit();
+    videoThread.wait();
+    backendThread.wait();
+    exportThread.wait();
+}
+
+bool BatchAnalyzer::start()
+{
+    // Sonuçlar ayrı thread'de biçimlendirilip yazılır, tespit akışı disk beklemez
+    exporter = new ResultExporter();
+    exporter->moveToThread(&exportThread);
+    connect(&exportThread, &QThread::finished, exporter, &QObject::deleteLater);
+    exportThread.start();
+
+    bool opened = false;
+    QMetaObject::invokeMethod(exporter, "open", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, opened),
+                              Q_ARG(QString, options.outputPath),
+                              Q_ARG(int, options.exportFormats));
+    if (!opened) {
+        return false;
+    }
+
+    videoController = new VideoController(&frameQueue, &framePool);
+    if (!videoController->openVideoDirectly(options.videoPath)) {
+        qDebug() << "BatchAnalyzer: Video açılamadı:" << options.videoPath;
+        delete videoController;
+        videoController = nullptr;
+        return false;
+    }
+    videoController->setOfflineMode(true);
+    videoController->setDecodeWorkers(options.decodeWorkers);
+    videoController->moveToThread(&videoThread);
+    connect(&videoThread, &QThread::finished, videoController, &QObject::deleteLater);
+    connect(videoController, &VideoController::videoFinished,
+            this, &BatchAnalyzer::onVideoFinished, Qt::QueuedConnection);
+
+    if (options.modelPath.isEmpty()) {
+        auto* communicator = new YOLOCommunicator(&detectionQueue);
+        communicator->setServerAddress(options.host, options.port);
+        communicator->setEndpoints(options.endpoints); // Boşsa tek adres kullanılır
+        communicator->setBatchSize(options.batchSize);
+        communicator->setBatchTimeoutMs(options.batchTimeoutMs);
+        communicator->setMaxInFlight(2 * options.batchSize);
+        backend = communicator;
+    } else {
+        backend = new OnnxDetector(&detectionQueue, options.modelPath);
+    }
+    backend->moveToThread(&backendThread);
+    connect(&backendThread, &QThread::finished, backend, &QObject::deleteLater);
+    connect(backend, &InferenceBackend::detectionReceived,
+            this, &BatchAnalyzer::onDetectionReceived, Qt::QueuedConnection);
+    connect(backend, &InferenceBackend::connectionStatusChanged,
+            this, &BatchAnalyzer::onBackendConnectionChanged, Qt::QueuedConnection);
+    connect(backend, &InferenceBackend::errorOccurred,
+            this, &BatchAnalyzer::onBackendError, Qt::QueuedConnection);
+
+    videoThread.start();
+    backendThread.start();
+
+    // Decode, backend hazır olunca başlar; aksi halde ilk frame'ler kuyrukta beklerdi
+    qDebug() << "BatchAnalyzer: Backend bekleniyor:" << backend->backendName();
+    QMetaObject::invokeMethod(backend, "startProcessing", Qt::QueuedConnection);
+    connectTimer.start(options.connectTimeoutMs);
+    return true;
+}
+
+void BatchAnalyzer::onBackendConnectionChanged(bool connected)
+{
+    if (!connected) {
+        // ONNX modeli yüklenemediyse tekrar deneme yoktur
+        if (!decodeStarted && !options.modelPath.isEmpty()) {
+            finish(1);
+        } else if (decodeStarted) {
+            qDebug() << "BatchAnalyzer: Backend bağlantısı koptu, yeniden bağlanması bekleniyor.";
+        }
+        return;
+    }
+
+    if (decodeStarted || isFinished) {
+        return;
+    }
+    connectTimer.stop();
+    decodeStarted = true;
+    runTimer.start();
+    idleTimer.start();
+
+    QMetaObject::invokeMethod(videoController, "startProcessing", Qt::QueuedConnection);
+    pumpTimer.start();
+    qDebug() << "BatchAnalyzer: Analiz başladı:" << options.videoPath;
+}
+
+void BatchAnalyzer::onConnectTimeout()
+{
+    qDebug() << "BatchAnalyzer: Backend" << options.connectTimeoutMs << "ms içinde hazır olmadı.";
+    finish(1);
+}
+
+void BatchAnalyzer::onBackendError(const QString& errorMessage)
+{
+    backendErrors++;
+    qDebug() << "BatchAnalyzer: Backend hatası:" << errorMessage;
+}
+
+void BatchAnalyzer::onVideoFinished()
+{
+    decodeFinished = true;
+    checkCompletion();
+}
+
+void BatchAnalyzer::pumpFrames()
+{
+    // Bekletilen frame önce gönderilir, sıra bozulmaz
+    if (hasHeldFrame) {
+        if (!forwardFrame(heldFrame)) {
+            return;
+        }
+        hasHeldFrame = false;
+    }
+
+    FrameData frameData;
+    for (int budget = 256; budget > 0 && frameQueue.try_pop(frameData); --budget) {
+        framesDecoded++;
+        if (frameData.frameId % options.detectionStride != 0) {
+            continue;
+        }
+        if (!forwardFrame(frameData)) {
+            heldFrame = std::move(frameData);
+            hasHeldFrame = true;
+            return;
+        }
+    }
+
+    checkCompletion();
+}
+
+bool BatchAnalyzer::forwardFrame(FrameData& frameData)
+{
+    const FrameMeta meta{frameData.frameNumber, frameData.timeStamp};
+    const int frameId = frameData.frameId;
+
+    // Offline analizde frame düşürülmez; kuyruk doluysa backend yetişene kadar beklenir
+    if (!detectionQueue.try_push(std::move(frameData))) {
+        return false;
+    }
+    pendingFrames.insert(frameId, meta);
+    framesForwarded++;
+    return true;
+}
+
+void BatchAnalyzer::onDetectionReceived(const DetectionResult& result)
+{
+    idleTimer.start();
+    const auto it = pendingFrames.constFind(result.frameId);
+    if (it == pendingFrames.constEnd()) {
+        return;
+    }
+    writeResult(result, *it);
+    pendingFrames.erase(it);
+    checkCompletion();
+}
+
+void BatchAnalyzer::writeResult(const DetectionResult& result, const FrameMeta& meta)
+{
+    ExportRecord record;
+    record.frameId = result.frameId;
+    record.frameNumber = meta.frameNumber;
+    record.timeStamp = meta.timeStamp;
+    record.result = result;
+    exporter->submit(std::move(record));
+
+    resultsWritten++;
+    detectionsWritten += result.detections.size();
+}
+
+void BatchAnalyzer::checkCompletion()
+{
+    if (isFinished || !decodeFinished || hasHeldFrame || !frameQueue.empty()) {
+        return;
+    }
+
+    // Zaman aşımına uğrayan istekler için sonsuza kadar beklenmez
+    if (pendingFrames.isEmpty() || idleTimer.elapsed() > 10000) {
+        if (!pendingFrames.isEmpty()) {
+            qDebug() << "BatchAnalyzer:" << pendingFrames.size() << "frame için sonuç alınamadı.";
+        }
+        finish(0);
+    }
+}
+
+void BatchAnalyzer::finish(int exitCode)
+{
+    if (isFinished) {
+        return;
+    }
+    isFinished = true;
+    pumpTimer.stop();
+    connectTimer.stop();
+
+    if (videoController) videoController->stopProcessing();
+    if (backend) backend->stopProcessing();
+
+    // Bekleyen kayıtlar yazılıp dosyalar kapanana kadar beklenir
+    if (exporter && exportThread.isRunning()) {
+        QMetaObject::invokeMethod(exporter, "close", Qt::BlockingQueuedConnection);
+    }
+
+    if (decodeStarted) {
+        printReport();
+    }
+    emit finished(exitCode);
+}
+
+void BatchAnalyzer::printReport()
+{
+    const double seconds = runTimer.elapsed() / 1000.0;
+    const double decodeFps = seconds > 0 ? framesDecoded / seconds : 0.0;
+    const double detectionFps = seconds > 0 ? resultsWritten / seconds : 0.0;
+
+    QTextStream out(stdout);
+    out << "Analiz tamamlandı: " << QFileInfo(options.videoPath).fileName() << "\n"
+        << "  Backend            : " << backend->backendName() << "\n"
+        << "  Decode edilen frame: " << framesDecoded << "\n"
+        << "  Tespit edilen frame: " << resultsWritten << " / " << framesForwarded
+        << " (stride " << options.detectionStride << ")\n"
+        << "  Toplam tespit      : " << detectionsWritten << "\n"
+        << "  Backend hataları   : " << backendErrors << "\n"
+        << "  Süre               : " << QString::number(seconds, 'f', 1) << " s\n"
+        << "  Decode FPS         : " << QString::number(decodeFps, 'f', 1) << "\n"
+        << "  Tespit FPS         : " << QString::number(detectionFps, 'f', 1) << "\n"
+        << "  Sonuçlar           : " << exporter->outputFiles().join(", ") << "\n";
+    out.flush();
+}
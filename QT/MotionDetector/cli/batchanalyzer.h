@@ -0,0 +1,108 @@
+#ifndef BATCHANALYZER_H
+#define BATCHANALYZER_H
+
+#include "ai/DetectionData.h"
+#include "ai/InferenceBackend.h"
+#include "core/FrameData.h"
+#include "core/FramePool.h"
+#include "core/ThreadQueue.h"
+#include "core/resultexporter.h"
+#include "core/videocontroller.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+
+// Komut satırından gelen analiz ayarları
+struct BatchOptions {
+    QString videoPath;
+    QString outputPath;             // Boşsa <video>.detections, uzantı biçime göre eklenir
+    int exportFormats = ResultExporter::JsonLines;
+    int detectionStride = 1;        // Her kaçıncı frame tespit için gönderilir
+    int decodeWorkers = 0;          // 0: çekirdek sayısına göre
+    QString modelPath;              // .onnx verilirse süreç içi ONNX, yoksa Python servisi
+    QString host = "localhost";
+    int port = 8888;
+    QStringList endpoints;          // Birden fazla servis ("host:port"), verilirse host/port yerine
+    int batchSize = 8;              // Python servisi için toplu istek boyutu
+    int batchTimeoutMs = 20;
+    int connectTimeoutMs = 30000;
+};
+
+/*
+ Arayüzsüz (headless) toplu analiz
+ MainWindow'un yaptığı işi widget olmadan ve ekran hızına bağlı kalmadan yapar:
+ VideoController offline modda (segment paralel, beklemesiz) frame üretir,
+ her detectionStride'ıncı frame seçilen InferenceBackend'e gönderilir ve sonuçlar
+ ResultExporter ile (JSON Lines, CSV, ikili) diske yazılır. Hiçbir aşamada frame düşürülmez, yavaş olan
+ aşama öncekileri bekletir. Bittiğinde FPS raporu yazdırılır.
+ */
+class BatchAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BatchAnalyzer(const BatchOptions& options, QObject *parent = nullptr);
+    ~BatchAnalyzer();
+
+    // Videoyu ve çıktı dosyasını açar, backend'i başlatır. Hata varsa false döner.
+    bool start();
+
+signals:
+    void finished(int exitCode);
+
+private slots:
+    void onBackendConnectionChanged(bool connected);
+    void onDetectionReceived(const DetectionResult& result);
+    void onBackendError(const QString& errorMessage);
+    void onVideoFinished();
+    void onConnectTimeout();
+    void pumpFrames();
+
+private:
+    struct FrameMeta {
+        int frameNumber = -1;
+        double timeStamp = 0.0;
+    };
+
+    bool forwardFrame(FrameData& frameData);
+    void writeResult(const DetectionResult& result, const FrameMeta& meta);
+    void checkCompletion();
+    void finish(int exitCode);
+    void printReport();
+
+    BatchOptions options;
+
+    // VideoController -> analiz -> backend zinciri
+    FramePool framePool;
+    FrameQueue frameQueue;
+    FrameQueue detectionQueue;
+    QThread videoThread;
+    QThread backendThread;
+    QThread exportThread;
+    VideoController* videoController;
+    InferenceBackend* backend;
+    ResultExporter* exporter;
+
+    QTimer pumpTimer;
+    QTimer connectTimer;
+
+    QHash<int, FrameMeta> pendingFrames; // Sonucu beklenen frame'lerin bilgileri
+    FrameData heldFrame;            // Tespit kuyruğu doluyken bekletilen frame
+    bool hasHeldFrame;
+    bool decodeStarted;
+    bool decodeFinished;
+    bool isFinished;
+
+    QElapsedTimer runTimer;
+    QElapsedTimer idleTimer;        // Son sonuçtan bu yana geçen süre
+    quint64 framesDecoded;
+    quint64 framesForwarded;
+    quint64 resultsWritten;
+    quint64 detectionsWritten;
+    quint64 backendErrors;
+};
+
+#endif // BATCHANALYZER_H
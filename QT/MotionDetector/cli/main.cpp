@@ -0,0 +1,66 @@
+#include "batchanalyzer.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+
+/*
+ MotionDetectionCli: sunucularda arayüzsüz, gerçek zamandan hızlı toplu analiz
+ Örnek:
+   MotionDetectionCli otopark.mp4 --stride 3 --batch 16
+   MotionDetectionCli otopark.mp4 --model yolov8n.onnx -o sonuc --format csv,jsonl,bin
+   MotionDetectionCli otopark.mp4 --endpoints localhost:8888,localhost:8889,localhost:8890
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("MotionDetectionCli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Videoyu ekran hızına bağlı kalmadan analiz eder ve tespitleri JSON Lines, CSV veya ikili biçimde yazar.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("video", "Analiz edilecek video dosyası");
+
+    QCommandLineOption outputOption({"o", "output"}, "Sonuç dosyası tabanı, uzantı biçime göre eklenir (varsayılan: <video>.detections)", "path");
+    QCommandLineOption formatOption({"f", "format"}, "Çıktı biçimleri: csv, jsonl, bin (virgülle ayrılmış)", "list", "jsonl");
+    QCommandLineOption strideOption({"s", "stride"}, "Her N frame'de bir tespit yap (varsayılan: 1)", "N", "1");
+    QCommandLineOption workersOption({"w", "workers"}, "Paralel decode worker sayısı (0: otomatik)", "N", "0");
+    QCommandLineOption modelOption({"m", "model"}, "Süreç içi çalıştırılacak ONNX modeli (verilmezse Python servisi)", "path");
+    QCommandLineOption hostOption("host", "Python YOLO servisi adresi", "host", "localhost");
+    QCommandLineOption portOption("port", "Python YOLO servisi portu", "port", "8888");
+    QCommandLineOption endpointsOption("endpoints", "Birden fazla Python YOLO servisi, frame'ler en az yüklü olana gider (host:port, virgülle ayrılmış)", "list");
+    QCommandLineOption batchOption({"b", "batch"}, "Python servisi için toplu istek boyutu", "N", "8");
+    QCommandLineOption batchWaitOption("batch-wait", "Batch dolması için en fazla bekleme (ms)", "ms", "20");
+    parser.addOptions({outputOption, formatOption, strideOption, workersOption, modelOption,
+                       hostOption, portOption, endpointsOption, batchOption, batchWaitOption});
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    BatchOptions options;
+    options.videoPath = positional.first();
+    options.outputPath = parser.value(outputOption);
+    options.exportFormats = ResultExporter::parseFormats(parser.value(formatOption));
+    if (options.exportFormats == 0) {
+        qDebug() << "Geçersiz biçim listesi:" << parser.value(formatOption);
+        return 1;
+    }
+    options.detectionStride = parser.value(strideOption).toInt();
+    options.decodeWorkers = parser.value(workersOption).toInt();
+    options.modelPath = parser.value(modelOption);
+    options.host = parser.value(hostOption);
+    options.port = parser.value(portOption).toInt();
+    options.endpoints = parser.value(endpointsOption).split(',', Qt::SkipEmptyParts);
+    options.batchSize = qMax(1, parser.value(batchOption).toInt());
+    options.batchTimeoutMs = parser.value(batchWaitOption).toInt();
+
+    BatchAnalyzer analyzer(options);
+    QObject::connect(&analyzer, &BatchAnalyzer::finished,
+                     &app, &QCoreApplication::exit, Qt::QueuedConnection);
+    if (!analyzer.start()) {
+        return 1;
+    }
+    return app.exec();
+}
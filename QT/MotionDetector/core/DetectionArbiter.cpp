@@ -0,0 +1,96 @@
+#include "DetectionArbiter.h"
+#include <QStringList>
+
+namespace {
+constexpr qint64 StaleRequestNs = 250 * 1000000LL; // Daha eski istek bekleyen sayılmaz
+}
+
+DetectionArbiter::DetectionArbiter()
+    : turn(0),
+    activeCount(0)
+{
+    for (int i = 0; i < MaxStreams; ++i) {
+        active[i] = false;
+        lastRequestNs[i] = -1;
+        grantCount[i] = 0;
+    }
+    clock.start();
+}
+
+void DetectionArbiter::setStreamActive(int streamId, bool enabled)
+{
+    if (streamId < 0 || streamId >= MaxStreams) {
+        return;
+    }
+    if (active[streamId].exchange(enabled) != enabled) {
+        activeCount += enabled ? 1 : -1;
+    }
+    lastRequestNs[streamId] = -1;
+}
+
+bool DetectionArbiter::tryAcquire(int streamId)
+{
+    if (streamId < 0 || streamId >= MaxStreams) {
+        return true;
+    }
+
+    // Sıra turn'den başlayarak dolaşılır: streamId'den önce bekleyen bir akış
+    // varsa izin onundur, streamId bekleyenlere eklenir
+    const qint64 now = clock.nsecsElapsed();
+    int start = turn;
+    for (int i = 0; i < MaxStreams; ++i) {
+        const int candidate = (start + i) % MaxStreams;
+        if (candidate == streamId) {
+            break;
+        }
+        if (isWaiting(candidate, now)) {
+            lastRequestNs[streamId] = now;
+            return false;
+        }
+    }
+
+    // Aynı anda izin alan başka bir akış sırayı değiştirdiyse bu tur kaybedilir
+    if (!turn.compare_exchange_strong(start, (streamId + 1) % MaxStreams)) {
+        lastRequestNs[streamId] = now;
+        return false;
+    }
+    lastRequestNs[streamId] = -1;
+    grantCount[streamId].fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void DetectionArbiter::reset()
+{
+    turn = 0;
+    for (int i = 0; i < MaxStreams; ++i) {
+        lastRequestNs[i] = -1;
+        grantCount[i] = 0;
+    }
+}
+
+bool DetectionArbiter::isWaiting(int streamId, qint64 now) const
+{
+    const qint64 requested = lastRequestNs[streamId];
+    return active[streamId] && requested >= 0 && now - requested < StaleRequestNs;
+}
+
+quint64 DetectionArbiter::granted(int streamId) const
+{
+    if (streamId < 0 || streamId >= MaxStreams) {
+        return 0;
+    }
+    return grantCount[streamId].load(std::memory_order_relaxed);
+}
+
+QString DetectionArbiter::getInfo() const
+{
+    QStringList grants;
+    for (int i = 0; i < MaxStreams; ++i) {
+        if (active[i]) {
+            grants << QString("%1:%2").arg(i).arg(granted(i));
+        }
+    }
+    return QString("DetectionArbiter[Streams:%1, Granted:{%2}]")
+        .arg(activeStreams())
+        .arg(grants.join(", "));
+}
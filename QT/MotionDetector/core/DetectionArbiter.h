@@ -0,0 +1,44 @@
+#ifndef DETECTIONARBITER_H
+#define DETECTIONARBITER_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <array>
+#include <atomic>
+
+/*
+ Çoklu izlemede tek tespit kuyruğunu paylaşan akışlar arasında sıra (round-robin)
+ Her akışın DetectionScheduler'ı kuyruk boşaldığında frame göndermek ister;
+ arbiter sırayı tutar ve sıradaki akış da bekliyorsa diğerlerine izin vermez.
+ Böylece decode hızı yüksek bir akış backend'i tekeline alamaz. Bir süredir
+ istekte bulunmayan (duraklatılmış, stride beklemesindeki) akışın sırası atlanır.
+ tryAcquire() akışların Video Thread'lerinden, diğerleri Ana Thread'den çağrılır.
+ */
+class DetectionArbiter {
+public:
+    static constexpr int MaxStreams = 16;
+
+    DetectionArbiter();
+
+    void setStreamActive(int streamId, bool enabled);
+    int activeStreams() const { return activeCount; }
+
+    // streamId'nin bu frame'i tespite göndermesine izin verilir mi?
+    bool tryAcquire(int streamId);
+    void reset();
+
+    quint64 granted(int streamId) const;
+    QString getInfo() const;
+
+private:
+    bool isWaiting(int streamId, qint64 now) const;
+
+    QElapsedTimer clock;
+    std::atomic<int> turn;                               // Önceliği olan akış
+    std::atomic<int> activeCount;
+    std::array<std::atomic<bool>, MaxStreams> active;
+    std::array<std::atomic<qint64>, MaxStreams> lastRequestNs;  // Reddedilen son istek, -1: beklemiyor
+    std::array<std::atomic<quint64>, MaxStreams> grantCount;
+};
+
+#endif // DETECTIONARBITER_H
@@ -0,0 +1,120 @@
+#include "DetectionScheduler.h"
+#include <cmath>
+
+namespace {
+constexpr double MaxFrameGapMs = 1000.0; // Daha uzun aralık duraklatma/seek'tir, ölçüme katılmaz
+}
+
+DetectionScheduler::DetectionScheduler()
+    : DetectionScheduler(Config())
+{
+}
+
+DetectionScheduler::DetectionScheduler(const Config& config)
+    : config(config),
+    arbiter(nullptr),
+    streamId(0),
+    lastForwardedId(-1),
+    lastFrameNs(-1),
+    resetRequested(false),
+    frameIntervalMs(0.0),
+    latencyMs(0.0),
+    sceneActive(true),
+    concurrency(qMax(1, config.concurrency)),
+    stride(config.minStride),
+    forwardedCount(0),
+    busySkipCount(0),
+    turnSkipCount(0)
+{
+    clock.start();
+}
+
+bool DetectionScheduler::shouldForward(int frameId, int queueDepth)
+{
+    if (resetRequested.exchange(false)) {
+        lastForwardedId = -1;
+        lastFrameNs = -1;
+    }
+
+    // Frame aralığı decode hızından ölçülür: canlı oynatmada video FPS x hız,
+    // offline analizde decode hızı
+    const qint64 now = clock.nsecsElapsed();
+    if (lastFrameNs >= 0) {
+        const double interval = (now - lastFrameNs) / 1.0e6;
+        if (interval < MaxFrameGapMs) {
+            const double previous = frameIntervalMs;
+            frameIntervalMs = previous > 0 ? previous + (interval - previous) * config.smoothing : interval;
+        }
+    }
+    lastFrameNs = now;
+
+    const int current = computeStride();
+    stride = current;
+    if (lastForwardedId >= 0 && frameId > lastForwardedId && frameId - lastForwardedId < current) {
+        return false;
+    }
+
+    // Backend önceki frame'i henüz almadıysa yenisi kuyruğa eklenmez (birikme olmaz)
+    if (queueDepth > 0) {
+        busySkipCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Kuyruk başka akışlarla paylaşılıyorsa sıra bekleyen akışındır
+    if (arbiter && !arbiter->tryAcquire(streamId)) {
+        turnSkipCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    lastForwardedId = frameId;
+    forwardedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void DetectionScheduler::recordResult(double roundTripMs)
+{
+    if (roundTripMs <= 0) {
+        return;
+    }
+    const double previous = latencyMs;
+    latencyMs = previous > 0 ? previous + (roundTripMs - previous) * config.smoothing : roundTripMs;
+}
+
+void DetectionScheduler::reset()
+{
+    resetRequested = true;
+    frameIntervalMs = 0.0;
+    latencyMs = 0.0;
+    sceneActive = true;
+    stride = config.minStride;
+}
+
+int DetectionScheduler::computeStride() const
+{
+    const double interval = frameIntervalMs;
+    const double latency = latencyMs;
+    if (interval <= 0 || latency <= 0) {
+        return config.minStride; // Ölçüm yokken en sık adım
+    }
+
+    // Backend'i paylaşan her akış kendi payını alır
+    const int streams = arbiter ? qMax(1, arbiter->activeStreams()) : 1;
+    double frames = latency / interval / concurrency * streams;
+    if (!sceneActive) {
+        frames *= config.idleFactor;
+    }
+    return qBound(config.minStride, static_cast<int>(std::ceil(frames)), config.maxStride);
+}
+
+QString DetectionScheduler::getInfo() const
+{
+    return QString("DetectionScheduler[Stream:%1, Stride:%2, Latency:%3ms, FrameInterval:%4ms, Active:%5, Forwarded:%6, BusySkips:%7, TurnSkips:%8]")
+        .arg(streamId)
+        .arg(stride.load())
+        .arg(latencyMs.load(), 0, 'f', 1)
+        .arg(frameIntervalMs.load(), 0, 'f', 1)
+        .arg(sceneActive.load() ? "Yes" : "No")
+        .arg(forwardedCount.load(std::memory_order_relaxed))
+        .arg(busySkipCount.load(std::memory_order_relaxed))
+        .arg(turnSkipCount.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,70 @@
+#ifndef DETECTIONSCHEDULER_H
+#define DETECTIONSCHEDULER_H
+
+#include "core/DetectionArbiter.h"
+#include <QElapsedTimer>
+#include <QString>
+#include <atomic>
+
+/*
+ Hangi frame'in tespite gönderileceğine karar veren zamanlayıcı
+ Sabit "her N frame'de bir" yerine adım (stride) ölçülen değerlerden hesaplanır:
+   stride = tespit gidiş-dönüş süresi / frame aralığı / eşzamanlı istek sayısı
+ Sahnede hareket yoksa adım idleFactor ile büyütülür, sonuç [minStride, maxStride]
+ aralığına kırpılır. Tespit kuyruğunda bekleyen frame varken yenisi eklenmez:
+ backend boşaldığında en taze frame gider, eski frame'ler birikmez.
+ Çoklu izlemede backend akışlar arasında paylaşılır: adım aktif akış sayısı ile
+ çarpılır ve gönderim sırası DetectionArbiter'dan alınır.
+ shouldForward() Video Thread'den, diğerleri Ana Thread'den çağrılır.
+ */
+class DetectionScheduler {
+public:
+    struct Config {
+        int minStride = 2;          // En sık: her 2 frame'de bir
+        int maxStride = 20;         // En seyrek (DetectionStore aralığından küçük kalmalı)
+        int concurrency = 1;        // Backend'in aynı anda işlediği istek sayısı
+        double idleFactor = 2.0;    // Hareket yokken adım çarpanı
+        double smoothing = 0.2;     // Ölçümler için üstel ortalama katsayısı
+    };
+
+    DetectionScheduler();
+    explicit DetectionScheduler(const Config& config);
+
+    // frameId tespite gönderilmeli mi? queueDepth: tespit kuyruğundaki frame sayısı
+    bool shouldForward(int frameId, int queueDepth);
+
+    void recordResult(double roundTripMs);
+    void setSceneActive(bool active) { sceneActive = active; }
+    void setConcurrency(int requests) { concurrency = qMax(1, requests); }
+    // Paylaşılan backend için sıra: arbiter ve bu scheduler'ın akış kimliği
+    void setArbiter(DetectionArbiter* sharedArbiter, int stream) { arbiter = sharedArbiter; streamId = stream; }
+    // Yeni video: frameId'ler sıfırdan başlar, ölçümler sıfırlanır
+    void reset();
+
+    int currentStride() const { return stride; }
+    QString getInfo() const;
+
+private:
+    int computeStride() const;
+
+    Config config;
+    QElapsedTimer clock;
+    DetectionArbiter* arbiter;
+    int streamId;
+
+    // Sadece Video Thread
+    int lastForwardedId;
+    qint64 lastFrameNs;
+
+    std::atomic<bool> resetRequested;
+    std::atomic<double> frameIntervalMs;
+    std::atomic<double> latencyMs;
+    std::atomic<bool> sceneActive;
+    std::atomic<int> concurrency;
+    std::atomic<int> stride;
+    std::atomic<quint64> forwardedCount;
+    std::atomic<quint64> busySkipCount;
+    std::atomic<quint64> turnSkipCount;
+};
+
+#endif // DETECTIONSCHEDULER_H
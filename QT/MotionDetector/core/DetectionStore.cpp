@@ -0,0 +1,221 @@
+#include "DetectionStore.h"
+#include <cmath>
+
+namespace {
+
+double intersectionOverUnion(const cv::Rect& a, const cv::Rect& b)
+{
+    const double intersection = (a & b).area();
+    const double unionArea = a.area() + b.area() - intersection;
+    return unionArea > 0 ? intersection / unionArea : 0.0;
+}
+
+int lerp(int a, int b, double t)
+{
+    return static_cast<int>(std::lround(a + (b - a) * t));
+}
+
+} // namespace
+
+DetectionStore::DetectionStore(int capacity)
+    : ring(qMax(1, capacity)),
+    capacity(qMax(1, capacity)),
+    newestFrameId(-1),
+    segmentStart(0),
+    resultCount(0),
+    detectionCount(0),
+    windowResults(0),
+    windowDetections(0),
+    windowProcessingMs(0.0)
+{
+}
+
+void DetectionStore::insert(const DetectionResult& result)
+{
+    if (result.frameId < 0) {
+        return;
+    }
+    store(result);
+    resultCount++;
+    detectionCount += result.detections.size();
+}
+
+bool DetectionStore::carryForward(int frameId)
+{
+    const DetectionResult* latest = find(newestFrameId);
+    if (!latest || frameId <= newestFrameId ||
+        (frameId >= segmentStart && newestFrameId < segmentStart)) {
+        return false;
+    }
+    DetectionResult carried = *latest;
+    carried.frameId = frameId;
+    store(carried);
+    return true;
+}
+
+void DetectionStore::store(const DetectionResult& result)
+{
+    Slot& slot = ring[slotIndex(result.frameId)];
+    if (slot.frameId >= 0) {
+        // Yuvadaki eski sonuç (ya da aynı frame'in önceki sonucu) pencereden çıkar
+        windowResults--;
+        windowDetections -= slot.result.detections.size();
+        windowProcessingMs -= slot.result.processingTimeMs;
+    }
+
+    slot.frameId = result.frameId;
+    slot.result = result;
+    newestFrameId = qMax(newestFrameId, result.frameId);
+
+    windowResults++;
+    windowDetections += result.detections.size();
+    windowProcessingMs += result.processingTimeMs;
+}
+
+const DetectionResult* DetectionStore::find(int frameId) const
+{
+    if (frameId < 0) {
+        return nullptr;
+    }
+    const Slot& slot = ring[slotIndex(frameId)];
+    return slot.frameId == frameId ? &slot.result : nullptr;
+}
+
+void DetectionStore::beginSegment(int firstFrameId)
+{
+    segmentStart = qMax(0, firstFrameId);
+}
+
+void DetectionStore::clear()
+{
+    for (Slot& slot : ring) {
+        slot = Slot();
+    }
+    newestFrameId = -1;
+    segmentStart = 0;
+    resultCount = 0;
+    detectionCount = 0;
+    windowResults = 0;
+    windowDetections = 0;
+    windowProcessingMs = 0.0;
+}
+
+bool DetectionStore::resolve(int frameId, int maxGapFrames, DetectionResult& out,
+                             const ObjectTracker* tracker) const
+{
+    if (const DetectionResult* exact = find(frameId)) {
+        out = *exact;
+        return true;
+    }
+
+    // Komşu sonuçlar en fazla maxGapFrames uzakta aranır, arama sınırlıdır
+    // Video geçişinin iki yanındaki sonuçlar birbirine karıştırılmaz
+    const int gap = qMin(maxGapFrames, capacity - 1);
+    const bool inSegment = frameId >= segmentStart;
+    const int lowestId = inSegment ? segmentStart : 0;
+    const int highestId = inSegment ? newestFrameId : qMin(newestFrameId, segmentStart - 1);
+    const DetectionResult* before = nullptr;
+    for (int id = frameId - 1; id >= qMax(lowestId, frameId - gap); --id) {
+        if ((before = find(id))) break;
+    }
+    if (!before) {
+        return false;
+    }
+
+    const DetectionResult* after = nullptr;
+    const int lastId = qMin(highestId, before->frameId + gap);
+    for (int id = frameId + 1; id <= lastId; ++id) {
+        if ((after = find(id))) break;
+    }
+
+    if (!after) {
+        // Sonraki tespit henüz gelmedi: izler Kalman tahmini ile ilerletilir,
+        // tracker yoksa (ya da daha yeni bir sonuçla beslendiyse) son sonuç tutulur
+        if (tracker && tracker->lastUpdateFrameId() == before->frameId) {
+            return tracker->predict(frameId, out);
+        }
+        out = *before;
+        return true;
+    }
+
+    const double t = static_cast<double>(frameId - before->frameId) / (after->frameId - before->frameId);
+    out = interpolate(*before, *after, t);
+    return true;
+}
+
+DetectionResult DetectionStore::interpolate(const DetectionResult& before, const DetectionResult& after, double t)
+{
+    DetectionResult result;
+    result.frameId = before.frameId;
+    result.success = true;
+    result.processingTimeMs = before.processingTimeMs;
+
+    // Kutular önce trackId ile, izlenmeyenler aynı sınıf ve en yüksek IoU ile eşleştirilir (açgözlü)
+    QVector<bool> used(after.detections.size(), false);
+    for (const Detection& from : before.detections) {
+        int bestIndex = -1;
+        double bestIou = 0.3; // Bunun altı farklı nesne sayılır
+        for (int i = 0; i < after.detections.size(); ++i) {
+            const Detection& to = after.detections[i];
+            if (used[i]) continue;
+            if (from.trackId >= 0 && to.trackId >= 0) {
+                if (from.trackId == to.trackId) {
+                    bestIndex = i;
+                    break;
+                }
+                continue;
+            }
+            if (to.classId != from.classId) continue;
+            const double iou = intersectionOverUnion(from.bbox, to.bbox);
+            if (iou > bestIou) {
+                bestIou = iou;
+                bestIndex = i;
+            }
+        }
+
+        if (bestIndex < 0) {
+            // Eşi olmayan kutu kaybolan nesnedir, aralığın ilk yarısında gösterilir
+            if (t < 0.5) result.detections.append(from);
+            continue;
+        }
+
+        used[bestIndex] = true;
+        const Detection& to = after.detections[bestIndex];
+        Detection blended = from;
+        blended.bbox = cv::Rect(lerp(from.bbox.x, to.bbox.x, t),
+                                lerp(from.bbox.y, to.bbox.y, t),
+                                lerp(from.bbox.width, to.bbox.width, t),
+                                lerp(from.bbox.height, to.bbox.height, t));
+        blended.confidence = from.confidence + (to.confidence - from.confidence) * t;
+        result.detections.append(blended);
+    }
+
+    // Yeni beliren nesneler aralığın ikinci yarısında gösterilir
+    if (t >= 0.5) {
+        for (int i = 0; i < after.detections.size(); ++i) {
+            if (!used[i]) result.detections.append(after.detections[i]);
+        }
+    }
+    return result;
+}
+
+double DetectionStore::averageObjects() const
+{
+    return windowResults > 0 ? static_cast<double>(windowDetections) / windowResults : 0.0;
+}
+
+double DetectionStore::averageProcessingMs() const
+{
+    return windowResults > 0 ? windowProcessingMs / windowResults : 0.0;
+}
+
+QString DetectionStore::getInfo() const
+{
+    return QString("DetectionStore[Stored:%1/%2, Results:%3, Detections:%4, AvgObjects:%5, AvgTime:%6ms]")
+        .arg(windowResults)
+        .arg(capacity)
+        .arg(resultCount)
+        .arg(detectionCount)
+        .arg(averageObjects(), 0, 'f', 1)
+        .arg(averageProcessingMs(), 0, 'f', 1);
+}
@@ -0,0 +1,74 @@
+#ifndef DETECTIONSTORE_H
+#define DETECTIONSTORE_H
+
+#include "ai/DetectionData.h"
+#include "core/ObjectTracker.h"
+#include <QString>
+#include <QVector>
+
+/*
+ frameId ile indekslenen sabit kapasiteli tespit deposu
+ Sonuç frameId % capacity yuvasına yazılır: ekleme, arama ve en eskiyi
+ silme O(1)'dir, ayrıca temizlik gerekmez. Yuvada saklanan frameId ile
+ eski (üzerine yazılmış) sonuçlar ayırt edilir.
+ Tespit seyrek yapıldığında (DetectionScheduler adımı) aradaki frame'ler
+ için kutular iki komşu sonuç arasında doğrusal olarak ara değerlenir.
+ Sadece Ana Thread'den kullanılır.
+ */
+class DetectionStore {
+public:
+    explicit DetectionStore(int capacity = 512);
+
+    void insert(const DetectionResult& result);
+    // Tespit atlanan (hareket yok) frame için en yeni sonuç o frame'e kopyalanır,
+    // böylece boşluk ara değerleme aralığını aşsa da kutular ekranda kalır.
+    // Oturum toplamlarına sayılmaz.
+    bool carryForward(int frameId);
+    const DetectionResult* find(int frameId) const;
+    bool contains(int frameId) const { return find(frameId) != nullptr; }
+    void clear();
+    // Playlist'te sıradaki videoya geçildi: firstFrameId ve sonrası, önceki
+    // videonun sonuçlarıyla ara değerlenmez ve onlardan kutu devralmaz
+    void beginSegment(int firstFrameId);
+
+    // frameId'de gösterilecek tespitler. Önce tam eşleşme, sonra maxGapFrames
+    // içindeki önceki ve sonraki sonuç arasında interpolasyon. Sonraki sonuç
+    // henüz yoksa tracker verilmişse kutular onun tahmininden, verilmemişse
+    // önceki sonuçtan alınır. out.frameId kaynak sonucun kimliğidir.
+    bool resolve(int frameId, int maxGapFrames, DetectionResult& out,
+                 const ObjectTracker* tracker = nullptr) const;
+
+    // Oturum boyunca toplamlar
+    quint64 totalResults() const { return resultCount; }
+    quint64 totalDetections() const { return detectionCount; }
+    // Depodaki (son capacity frame) sonuçlar üzerinden
+    int storedResults() const { return windowResults; }
+    double averageObjects() const;
+    double averageProcessingMs() const;
+    int latestFrameId() const { return newestFrameId; }
+
+    QString getInfo() const;
+
+private:
+    struct Slot {
+        int frameId = -1;
+        DetectionResult result;
+    };
+
+    int slotIndex(int frameId) const { return frameId % capacity; }
+    void store(const DetectionResult& result);
+    static DetectionResult interpolate(const DetectionResult& before, const DetectionResult& after, double t);
+
+    QVector<Slot> ring;
+    int capacity;
+    int newestFrameId;
+    int segmentStart;
+
+    quint64 resultCount;
+    quint64 detectionCount;
+    int windowResults;
+    qint64 windowDetections;
+    double windowProcessingMs;
+};
+
+#endif // DETECTIONSTORE_H
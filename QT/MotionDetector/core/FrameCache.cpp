@@ -0,0 +1,119 @@
+#include "FrameCache.h"
+
+FrameCache::FrameCache(qint64 maxBytes)
+    : maxBytes(qMax<qint64>(0, maxBytes)),
+    maxFrames(0),
+    usedBytes(0),
+    hitCount(0),
+    missCount(0)
+{
+}
+
+void FrameCache::setBudget(qint64 bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxBytes = qMax<qint64>(0, bytes);
+    evictLocked();
+}
+
+void FrameCache::setMaxFrames(int count)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxFrames = qMax(0, count);
+    evictLocked();
+}
+
+qint64 FrameCache::budget() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxBytes;
+}
+
+void FrameCache::insert(const FrameData& frameData)
+{
+    if (frameData.frame.empty() || frameData.frameNumber < 0) {
+        return;
+    }
+    const qint64 frameBytes = static_cast<qint64>(frameData.frame.total() * frameData.frame.elemSize());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (frameBytes > maxBytes) {
+        return; // Bütçeye tek başına sığmayan frame saklanmaz
+    }
+
+    const auto existing = lookup.constFind(frameData.frameNumber);
+    if (existing != lookup.constEnd()) {
+        usedBytes -= (*existing)->bytes;
+        entries.erase(*existing);
+        lookup.erase(existing);
+    }
+
+    entries.push_front({frameData.frameNumber, frameData, frameBytes});
+    lookup.insert(frameData.frameNumber, entries.begin());
+    usedBytes += frameBytes;
+    evictLocked();
+}
+
+bool FrameCache::get(int frameNumber, FrameData& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = lookup.constFind(frameNumber);
+    if (it == lookup.constEnd()) {
+        missCount++;
+        return false;
+    }
+
+    // splice iterator'ları geçersiz kılmaz, lookup güncellenmez
+    entries.splice(entries.begin(), entries, *it);
+    out = (*it)->frameData;
+    hitCount++;
+    return true;
+}
+
+bool FrameCache::contains(int frameNumber) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lookup.contains(frameNumber);
+}
+
+void FrameCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear(); // Slab'lar havuza döner
+    lookup.clear();
+    usedBytes = 0;
+}
+
+void FrameCache::evictLocked()
+{
+    while (!entries.empty() &&
+           (usedBytes > maxBytes || (maxFrames > 0 && static_cast<int>(entries.size()) > maxFrames))) {
+        const Entry& oldest = entries.back();
+        usedBytes -= oldest.bytes;
+        lookup.remove(oldest.frameNumber);
+        entries.pop_back();
+    }
+}
+
+int FrameCache::count() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(entries.size());
+}
+
+qint64 FrameCache::bytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+QString FrameCache::getInfo() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const quint64 total = hitCount + missCount;
+    return QString("FrameCache[Frames:%1, Memory:%2/%3MB, HitRate:%4%]")
+        .arg(entries.size())
+        .arg(usedBytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(maxBytes / (1024.0 * 1024.0), 0, 'f', 0)
+        .arg(total > 0 ? 100.0 * hitCount / total : 0.0, 0, 'f', 1);
+}
@@ -0,0 +1,62 @@
+#ifndef FRAMECACHE_H
+#define FRAMECACHE_H
+
+#include "core/FrameData.h"
+#include <QHash>
+#include <QString>
+#include <list>
+#include <mutex>
+
+/*
+ Decode edilmiş frame'ler için bellek bütçeli LRU cache
+ Anahtar dosyadaki frameNumber'dır. Geri adım ve küçük scrub hareketleri
+ keyframe'den hedefe kadar yeniden decode yerine buradan karşılanır.
+ Frame'ler kopyalanmaz, cv::Mat header'ı saklanır; cache'teki bir frame
+ FramePool slab'ını tahliye edilene kadar kullanımda tutar.
+ */
+class FrameCache {
+public:
+    explicit FrameCache(qint64 maxBytes = 256LL * 1024 * 1024);
+
+    FrameCache(const FrameCache&) = delete;
+    FrameCache& operator=(const FrameCache&) = delete;
+
+    // Bütçe küçülürse en eski frame'ler hemen atılır
+    void setBudget(qint64 maxBytes);
+    qint64 budget() const;
+    // Frame sayısı sınırı (0: sınırsız). Cache havuz slab'larını tuttuğu için
+    // VideoController bunu havuz kapasitesinden ayarlar.
+    void setMaxFrames(int count);
+
+    // Aynı frameNumber varsa güncellenir ve en yeni konuma taşınır
+    void insert(const FrameData& frameData);
+    // Bulunursa frame en yeni konuma taşınır
+    bool get(int frameNumber, FrameData& out);
+    bool contains(int frameNumber) const;
+    void clear();
+
+    int count() const;
+    qint64 bytes() const;
+    QString getInfo() const;
+
+private:
+    struct Entry {
+        int frameNumber;
+        FrameData frameData;
+        qint64 bytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    void evictLocked();
+
+    mutable std::mutex mutex;
+    EntryList entries;                          // Baş: en son kullanılan
+    QHash<int, EntryList::iterator> lookup;
+    qint64 maxBytes;
+    int maxFrames;
+    qint64 usedBytes;
+    quint64 hitCount;
+    quint64 missCount;
+};
+
+#endif // FRAMECACHE_H
@@ -11,6 +11,7 @@ Frame ID sistemi ile hangi frame in ne zaman işlendiğini takip edebiliriz ve f
  */
 struct FrameData {
     int frameId = -1; // Kendi atayacağımız benzersiz frame kimliği
+    int streamId = 0; // Çoklu izlemede frame'in geldiği video akışı (0: ana video)
     double timeStamp = 0.0; // Video içindeki saniye cinsinden zaman
     int frameNumber = -1; //Video dosyasındaki frame numarası
     cv::Mat frame; // Görüntü verisi
@@ -0,0 +1,226 @@
+#include "FrameIndex.h"
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cmath>
+#include <opencv2/opencv.hpp>
+
+// Ham paket okuma (CAP_PROP_FORMAT = -1) ve keyframe bayrağı OpenCV 4.7 ile geldi
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 7)
+#define FRAME_INDEX_HAS_RAW_PACKETS 1
+#endif
+
+namespace {
+constexpr quint32 CacheMagic = 0x4D444958; // "MDIX"
+constexpr quint16 CacheVersion = 1;
+}
+
+FrameIndex::FrameIndex()
+    : packetCount(0),
+    fps(0.0),
+    sourceSize(0),
+    sourceModified(0)
+{
+}
+
+QString FrameIndex::cachePath(const QString& videoPath)
+{
+    return videoPath + ".mdindex";
+}
+
+FrameIndex FrameIndex::loadOrBuild(const QString& videoPath, const std::atomic<bool>* cancel)
+{
+    FrameIndex index;
+    if (index.load(videoPath)) {
+        qDebug() << "FrameIndex: Cache'ten okundu," << index.getInfo();
+        return index;
+    }
+
+    index = build(videoPath, cancel);
+    if (index.isValid() && !index.save(videoPath)) {
+        // Salt okunur klasörler için sorun değil, bir sonraki açılışta tekrar taranır
+        qDebug() << "FrameIndex: Cache yazılamadı:" << cachePath(videoPath);
+    }
+    return index;
+}
+
+FrameIndex FrameIndex::build(const QString& videoPath, const std::atomic<bool>* cancel)
+{
+    FrameIndex index;
+    const QFileInfo info(videoPath);
+    index.sourceSize = info.size();
+    index.sourceModified = info.lastModified().toMSecsSinceEpoch();
+
+#ifdef FRAME_INDEX_HAS_RAW_PACKETS
+    cv::VideoCapture capture(videoPath.toStdString(), cv::CAP_FFMPEG);
+    if (!capture.isOpened() || !capture.set(cv::CAP_PROP_FORMAT, -1)) {
+        qDebug() << "FrameIndex: Ham paket modu desteklenmiyor, index oluşturulamadı.";
+        return index;
+    }
+    index.fps = capture.get(cv::CAP_PROP_FPS);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Ham modda grab() paketi decode etmeden okur, bu yüzden tarama çok hızlıdır.
+    // Paketler decode sırasındadır; kapalı GOP'larda keyframe'in sırası değişmez.
+    int position = 0;
+    while (capture.grab()) {
+        if (cancel && *cancel) {
+            return FrameIndex();
+        }
+        if (capture.get(cv::CAP_PROP_LRF_HAS_KEY_FRAME) != 0) {
+            KeyframeEntry entry;
+            entry.frameNumber = position;
+            entry.timeStamp = capture.get(cv::CAP_PROP_POS_MSEC) / 1000.0;
+            if (entry.timeStamp <= 0.0 && position > 0 && index.fps > 0) {
+                entry.timeStamp = position / index.fps; // Paket zamanı yoksa tahmin et
+            }
+            index.keyframes.append(entry);
+        }
+        ++position;
+    }
+    index.packetCount = position;
+
+    qDebug() << "FrameIndex: Tarama" << timer.elapsed() << "ms sürdü," << index.getInfo();
+#else
+    Q_UNUSED(cancel);
+#endif
+    return index;
+}
+
+bool FrameIndex::load(const QString& videoPath)
+{
+    QFile file(cachePath(videoPath));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion) {
+        return false;
+    }
+
+    FrameIndex loaded;
+    qint32 frames = 0;
+    qint32 count = 0;
+    in >> loaded.sourceSize >> loaded.sourceModified >> loaded.fps >> frames >> count;
+
+    // Video değiştiyse cache eskidir
+    const QFileInfo info(videoPath);
+    if (loaded.sourceSize != info.size() ||
+        loaded.sourceModified != info.lastModified().toMSecsSinceEpoch() ||
+        frames <= 0 || count <= 0 || count > frames) {
+        return false;
+    }
+
+    loaded.packetCount = frames;
+    loaded.keyframes.resize(count);
+    for (KeyframeEntry& entry : loaded.keyframes) {
+        qint32 frameNumber = 0;
+        in >> frameNumber >> entry.timeStamp;
+        entry.frameNumber = frameNumber;
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    *this = loaded;
+    return true;
+}
+
+bool FrameIndex::save(const QString& videoPath) const
+{
+    // QSaveFile geçici dosyaya yazıp sonra yeniden adlandırır, yarım cache kalmaz
+    QSaveFile file(cachePath(videoPath));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << CacheMagic << CacheVersion
+        << sourceSize << sourceModified << fps
+        << static_cast<qint32>(packetCount) << static_cast<qint32>(keyframes.size());
+    for (const KeyframeEntry& entry : keyframes) {
+        out << static_cast<qint32>(entry.frameNumber) << entry.timeStamp;
+    }
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+int FrameIndex::entryBefore(int frameNumber) const
+{
+    const auto it = std::upper_bound(keyframes.cbegin(), keyframes.cend(), frameNumber,
+                                     [](int value, const KeyframeEntry& entry) {
+                                         return value < entry.frameNumber;
+                                     });
+    return static_cast<int>(it - keyframes.cbegin()) - 1;
+}
+
+int FrameIndex::entryBeforeTime(double seconds) const
+{
+    const auto it = std::upper_bound(keyframes.cbegin(), keyframes.cend(), seconds,
+                                     [](double value, const KeyframeEntry& entry) {
+                                         return value < entry.timeStamp;
+                                     });
+    return static_cast<int>(it - keyframes.cbegin()) - 1;
+}
+
+int FrameIndex::keyframeBefore(int frameNumber) const
+{
+    const int entry = entryBefore(frameNumber);
+    return entry >= 0 ? keyframes[entry].frameNumber : -1;
+}
+
+int FrameIndex::frameForTime(double seconds) const
+{
+    const int lastFrame = qMax(0, packetCount - 1);
+    const int entry = entryBeforeTime(seconds);
+    if (entry < 0 || fps <= 0) {
+        return fps > 0 ? qBound(0, static_cast<int>(std::floor(seconds * fps)), lastFrame) : 0;
+    }
+
+    // GOP içinde sabit frame aralığı varsayılır, değişken FPS hatası tek GOP ile sınırlı kalır
+    const KeyframeEntry& keyframe = keyframes[entry];
+    const int offset = static_cast<int>(std::floor((seconds - keyframe.timeStamp) * fps + 1e-6));
+    return qBound(0, keyframe.frameNumber + offset, lastFrame);
+}
+
+double FrameIndex::timeForFrame(int frameNumber) const
+{
+    const int entry = entryBefore(frameNumber);
+    if (entry < 0 || fps <= 0) {
+        return fps > 0 ? frameNumber / fps : 0.0;
+    }
+    const KeyframeEntry& keyframe = keyframes[entry];
+    return keyframe.timeStamp + (frameNumber - keyframe.frameNumber) / fps;
+}
+
+QVector<int> FrameIndex::keyframeNumbers() const
+{
+    QVector<int> numbers;
+    numbers.reserve(keyframes.size());
+    for (const KeyframeEntry& entry : keyframes) {
+        numbers.append(entry.frameNumber);
+    }
+    return numbers;
+}
+
+QString FrameIndex::getInfo() const
+{
+    return QString("FrameIndex[Frames:%1, Keyframes:%2, FPS:%3]")
+        .arg(packetCount)
+        .arg(keyframes.size())
+        .arg(fps, 0, 'f', 2);
+}
@@ -0,0 +1,62 @@
+#ifndef FRAMEINDEX_H
+#define FRAMEINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+/*
+ Video dosyasının keyframe ve zaman damgası index'i
+ Paketler decode edilmeden taranır (ham paket modu), her keyframe'in frame
+ numarası ve zamanı saklanır. Seek işlemleri hedeften önceki en yakın keyframe'e
+ atlayıp sadece oradan hedefe kadar decode eder. Tarama uzun dosyalarda birkaç
+ saniye sürebildiği için index videonun yanına <video>.mdindex olarak yazılır;
+ dosya boyutu ve değiştirilme zamanı tutmazsa cache geçersiz sayılır.
+ */
+
+struct KeyframeEntry {
+    int frameNumber = 0;    // 0 tabanlı frame numarası
+    double timeStamp = 0.0; // Saniye
+};
+
+class FrameIndex {
+public:
+    FrameIndex();
+
+    // Önce cache okunur, yoksa ya da eskiyse dosya taranıp cache yazılır.
+    // cancel true olursa tarama yarıda kesilir ve geçersiz index döner.
+    static FrameIndex loadOrBuild(const QString& videoPath, const std::atomic<bool>* cancel = nullptr);
+    static FrameIndex build(const QString& videoPath, const std::atomic<bool>* cancel = nullptr);
+    static QString cachePath(const QString& videoPath);
+
+    bool load(const QString& videoPath);
+    bool save(const QString& videoPath) const;
+
+    // Backend ham paket modunu desteklemiyorsa index boş kalır
+    bool isValid() const { return !keyframes.isEmpty() && packetCount > 0; }
+    int frameCount() const { return packetCount; }
+    int keyframeCount() const { return keyframes.size(); }
+    double frameRate() const { return fps; }
+
+    // frameNumber'dan önceki (ya da kendisi olan) en yakın keyframe, yoksa -1
+    int keyframeBefore(int frameNumber) const;
+    // Verilen zamanda ekranda olan frame (keyframe zamanlarından hesaplanır)
+    int frameForTime(double seconds) const;
+    double timeForFrame(int frameNumber) const;
+
+    QVector<int> keyframeNumbers() const;
+    QString getInfo() const;
+
+private:
+    // Arama yapılan keyframe'in listedeki sırası, yoksa -1
+    int entryBefore(int frameNumber) const;
+    int entryBeforeTime(double seconds) const;
+
+    QVector<KeyframeEntry> keyframes;
+    int packetCount;
+    double fps;
+    qint64 sourceSize;      // Cache doğrulaması için video dosyasının boyutu
+    qint64 sourceModified;  // ve değiştirilme zamanı (ms)
+};
+
+#endif // FRAMEINDEX_H
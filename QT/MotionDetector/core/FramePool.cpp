@@ -0,0 +1,104 @@
+#include "FramePool.h"
+#include <QDebug>
+
+FramePool::FramePool(int capacity)
+    : maxSlabs(capacity > 0 ? capacity : 1)
+{
+    slabs.reserve(maxSlabs);
+    qDebug() << "FramePool oluşturuldu, kapasite:" << maxSlabs;
+}
+
+FramePool::~FramePool()
+{
+    // Dışarıda kalan Mat'ler kendi referanslarıyla yaşamaya devam eder
+    qDebug() << "FramePool silindi," << getInfo();
+}
+
+bool FramePool::isFree(const cv::Mat& slab)
+{
+    // Sadece havuzdaki kopya kaldıysa slab boştadır.
+    // refcount OpenCV tarafından atomik güncellenir, aynı şekilde okuyoruz.
+    return slab.u && CV_XADD(&slab.u->refcount, 0) == 1;
+}
+
+bool FramePool::matches(const cv::Mat& slab, int rows, int cols, int type)
+{
+    return slab.rows == rows && slab.cols == cols && slab.type() == type;
+}
+
+cv::Mat FramePool::acquire(int rows, int cols, int type)
+{
+    if (rows <= 0 || cols <= 0) {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return cv::Mat();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    int reusable = -1; // Boyutu farklı ama boşta olan slab
+    for (size_t i = 0; i < slabs.size(); ++i) {
+        if (!isFree(slabs[i])) continue;
+        if (matches(slabs[i], rows, cols, type)) {
+            hitCount.fetch_add(1, std::memory_order_relaxed);
+            return slabs[i]; // Header kopyası, slab paylaşılır
+        }
+        if (reusable < 0) reusable = static_cast<int>(i);
+    }
+
+    missCount.fetch_add(1, std::memory_order_relaxed);
+
+    cv::Mat slab(rows, cols, type);
+    if (static_cast<int>(slabs.size()) < maxSlabs) {
+        slabs.push_back(slab);
+    } else if (reusable >= 0) {
+        // Video değişti, eski boyuttaki boş slab'ın yerini al
+        slabs[reusable] = slab;
+    }
+    // Havuz tamamen kullanımdaysa slab havuz dışı kalır ve normal şekilde serbest bırakılır
+    return slab;
+}
+
+void FramePool::reportReallocation()
+{
+    reallocCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FramePool::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    slabs.clear();
+}
+
+int FramePool::slabCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(slabs.size());
+}
+
+int FramePool::inUseCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    int count = 0;
+    for (const cv::Mat& slab : slabs) {
+        if (!isFree(slab)) count++;
+    }
+    return count;
+}
+
+double FramePool::hitRate() const
+{
+    const quint64 total = hits() + misses();
+    return total > 0 ? static_cast<double>(hits()) / total : 0.0;
+}
+
+QString FramePool::getInfo() const
+{
+    return QString("FramePool[Slabs:%1/%2, InUse:%3, Hits:%4, Misses:%5, HitRate:%6%, Realloc:%7]")
+        .arg(slabCount())
+        .arg(maxSlabs)
+        .arg(inUseCount())
+        .arg(hits())
+        .arg(misses())
+        .arg(hitRate() * 100.0, 0, 'f', 1)
+        .arg(reallocCount.load(std::memory_order_relaxed));
+}
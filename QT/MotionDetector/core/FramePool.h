@@ -0,0 +1,57 @@
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <opencv2/opencv.hpp>
+#include <QString>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/*
+ Decode edilen frame'ler için sabit boyutlu buffer havuzu
+ Her frame için clone() yapmak yerine önceden ayrılmış slab'lar tekrar kullanılır.
+ acquire() slab'ı paylaşan bir cv::Mat header'ı döndürür. Display ve detection
+ tarafındaki son kopya da silindiğinde (cv::Mat referans sayısı havuza düştüğünde)
+ slab otomatik olarak tekrar kullanılabilir hale gelir.
+ */
+class FramePool {
+public:
+    explicit FramePool(int capacity = 96);
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // Verilen boyutta bir buffer döndürür. Havuz doluysa ve boş slab yoksa
+    // havuz dışı geçici bir buffer ayrılır (miss olarak sayılır).
+    cv::Mat acquire(int rows, int cols, int type);
+
+    // Dönen buffer decode sırasında yeniden ayrıldıysa (örn. metadata ile gerçek
+    // frame boyutu farklı) çağıran taraf bunu bildirir.
+    void reportReallocation();
+
+    void clear();
+
+    int capacity() const { return maxSlabs; }
+    int slabCount() const;
+    int inUseCount() const;
+    quint64 hits() const { return hitCount.load(std::memory_order_relaxed); }
+    quint64 misses() const { return missCount.load(std::memory_order_relaxed); }
+    double hitRate() const;
+
+    QString getInfo() const;
+
+private:
+    static bool isFree(const cv::Mat& slab);
+    static bool matches(const cv::Mat& slab, int rows, int cols, int type);
+
+    mutable std::mutex mutex;
+    std::vector<cv::Mat> slabs;             // Havuzun sahip olduğu tüm slab'lar
+    int maxSlabs;                           // Maksimum slab sayısı
+
+    std::atomic<quint64> hitCount{0};       // Boş slab bulunan istekler
+    std::atomic<quint64> missCount{0};      // Yeni ayırma gerektiren istekler
+    std::atomic<quint64> reallocCount{0};   // Decode sırasında yeniden ayrılan buffer'lar
+};
+
+#endif // FRAMEPOOL_H
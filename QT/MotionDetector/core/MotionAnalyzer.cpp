@@ -0,0 +1,244 @@
+#include "MotionAnalyzer.h"
+#include <QDebug>
+#include <cmath>
+
+namespace {
+constexpr double RadiansToDegrees = 180.0 / 3.14159265358979323846;
+}
+
+MotionAnalyzer::MotionAnalyzer()
+    : MotionAnalyzer(Config())
+{
+}
+
+MotionAnalyzer::MotionAnalyzer(const Config& config)
+    : config(config),
+    count(0),
+    capacity(0),
+    lastTime(-1.0),
+    moving(0),
+    parkedNow(0),
+    averageSpeed(0.0),
+    trackTotal(0),
+    parkedTotal(0)
+{
+    slotOfTrack.reserve(qMax(1, config.initialCapacity));
+    while (capacity < config.initialCapacity) {
+        grow();
+    }
+}
+
+void MotionAnalyzer::update(const DetectionResult& detections, double timeStamp)
+{
+    if (timeStamp < lastTime) {
+        qDebug() << "MotionAnalyzer: Zaman geri gitti, izler sıfırlanıyor:" << timeStamp;
+        clear();
+    }
+    if (timeStamp == lastTime) {
+        return; // Aynı frame tekrar gösterildi (duraklatılmış seek, overlay tekrarı)
+    }
+    lastTime = timeStamp;
+
+    for (const Detection& detection : detections.detections) {
+        if (detection.trackId < 0 || !detection.isValid()) {
+            continue;
+        }
+        const cv::Rect& box = detection.bbox;
+        updateSlot(slotFor(detection, timeStamp),
+                   box.x + box.width / 2.0, box.y + box.height / 2.0, timeStamp);
+    }
+
+    // Süresi dolan izler kapatılır, kalanlar için özet çıkarılır. Geriye doğru
+    // gidildiği için yerine taşınan son iz zaten işlenmiş olur.
+    moving = 0;
+    parkedNow = 0;
+    double speedSum = 0.0;
+    for (int slot = count - 1; slot >= 0; --slot) {
+        if (timeStamp - lastSeen[slot] > config.staleSeconds) {
+            release(slot);
+            continue;
+        }
+        if (movingFlags[slot]) {
+            moving++;
+            speedSum += speeds[slot];
+        } else if (timeStamp - stationarySince[slot] >= config.parkedSeconds) {
+            parkedNow++;
+            if (!parkedFlags[slot]) {
+                parkedFlags[slot] = 1;
+                parkedTotal++;
+            }
+        }
+    }
+    averageSpeed = moving > 0 ? speedSum / moving : 0.0;
+}
+
+void MotionAnalyzer::updateSlot(int slot, double cx, double cy, double timeStamp)
+{
+    // Geçmiş halkasına yaz
+    const int base = slot * HistoryLength;
+    const int head = historyHead[slot];
+    historyX[base + head] = static_cast<float>(cx);
+    historyY[base + head] = static_cast<float>(cy);
+    historyT[base + head] = timeStamp;
+    historyHead[slot] = (head + 1) % HistoryLength;
+    historySize[slot] = qMin(historySize[slot] + 1, HistoryLength);
+    lastSeen[slot] = timeStamp;
+
+    // Hız, pencere en az speedWindow saniyeyi kapsayan en yeni eski örnekten ölçülür
+    int oldest = -1;
+    for (int k = 1; k < historySize[slot]; ++k) {
+        const int index = (head - k + HistoryLength) % HistoryLength;
+        if (timeStamp - historyT[base + index] >= config.speedWindow) {
+            oldest = index;
+            break;
+        }
+    }
+    if (oldest < 0) {
+        return; // Henüz yeterli geçmiş yok
+    }
+
+    const double dt = timeStamp - historyT[base + oldest];
+    const double dx = cx - historyX[base + oldest];
+    const double dy = cy - historyY[base + oldest];
+    const double instant = std::hypot(dx, dy) / dt;
+    speeds[slot] += (instant - speeds[slot]) * config.speedSmoothing;
+    if (instant > config.stationarySpeed) {
+        headings[slot] = std::atan2(dy, dx) * RadiansToDegrees; // Dururken yön gürültüdür, son yön tutulur
+    }
+
+    // Histerezis: iki eşik arasında durum değişmez
+    if (movingFlags[slot] && speeds[slot] < config.stationarySpeed) {
+        movingFlags[slot] = 0;
+        stationarySince[slot] = timeStamp;
+    } else if (!movingFlags[slot] && speeds[slot] > config.movingSpeed) {
+        movingFlags[slot] = 1;
+        stationaryTotal[slot] += timeStamp - stationarySince[slot];
+        stationarySince[slot] = -1.0;
+        parkedFlags[slot] = 0;
+    }
+}
+
+int MotionAnalyzer::slotFor(const Detection& detection, double timeStamp)
+{
+    auto it = slotOfTrack.constFind(detection.trackId);
+    if (it != slotOfTrack.constEnd()) {
+        return *it;
+    }
+
+    if (count == capacity) {
+        grow();
+    }
+
+    // Yeni iz duruyor kabul edilir, ilk hız ölçümü durumu belirler
+    const int slot = count++;
+    slotOfTrack.insert(detection.trackId, slot);
+    trackIds[slot] = detection.trackId;
+    classIds[slot] = detection.classId;
+    speeds[slot] = 0.0;
+    headings[slot] = 0.0;
+    firstSeen[slot] = timeStamp;
+    lastSeen[slot] = timeStamp;
+    stationarySince[slot] = timeStamp;
+    stationaryTotal[slot] = 0.0;
+    movingFlags[slot] = 0;
+    parkedFlags[slot] = 0;
+    historyHead[slot] = 0;
+    historySize[slot] = 0;
+    trackTotal++;
+    return slot;
+}
+
+void MotionAnalyzer::grow()
+{
+    capacity = qMax(64, capacity * 2);
+    trackIds.resize(capacity);
+    classIds.resize(capacity);
+    speeds.resize(capacity);
+    headings.resize(capacity);
+    firstSeen.resize(capacity);
+    lastSeen.resize(capacity);
+    stationarySince.resize(capacity);
+    stationaryTotal.resize(capacity);
+    movingFlags.resize(capacity);
+    parkedFlags.resize(capacity);
+    historyX.resize(capacity * HistoryLength);
+    historyY.resize(capacity * HistoryLength);
+    historyT.resize(capacity * HistoryLength);
+    historyHead.resize(capacity);
+    historySize.resize(capacity);
+}
+
+void MotionAnalyzer::release(int slot)
+{
+    slotOfTrack.remove(trackIds[slot]);
+    const int last = --count;
+    if (slot != last) {
+        moveSlot(last, slot);
+        slotOfTrack[trackIds[slot]] = slot;
+    }
+}
+
+void MotionAnalyzer::moveSlot(int from, int to)
+{
+    trackIds[to] = trackIds[from];
+    classIds[to] = classIds[from];
+    speeds[to] = speeds[from];
+    headings[to] = headings[from];
+    firstSeen[to] = firstSeen[from];
+    lastSeen[to] = lastSeen[from];
+    stationarySince[to] = stationarySince[from];
+    stationaryTotal[to] = stationaryTotal[from];
+    movingFlags[to] = movingFlags[from];
+    parkedFlags[to] = parkedFlags[from];
+    historyHead[to] = historyHead[from];
+    historySize[to] = historySize[from];
+    for (int k = 0; k < HistoryLength; ++k) {
+        historyX[to * HistoryLength + k] = historyX[from * HistoryLength + k];
+        historyY[to * HistoryLength + k] = historyY[from * HistoryLength + k];
+        historyT[to * HistoryLength + k] = historyT[from * HistoryLength + k];
+    }
+}
+
+bool MotionAnalyzer::motion(int trackId, TrackMotion& out) const
+{
+    auto it = slotOfTrack.constFind(trackId);
+    if (it == slotOfTrack.constEnd()) {
+        return false;
+    }
+
+    const int slot = *it;
+    out.trackId = trackIds[slot];
+    out.classId = classIds[slot];
+    out.speed = speeds[slot];
+    out.heading = headings[slot];
+    out.moving = movingFlags[slot] != 0;
+    out.parked = parkedFlags[slot] != 0;
+    out.firstSeen = firstSeen[slot];
+    out.lastSeen = lastSeen[slot];
+    out.dwellSeconds = out.moving ? 0.0 : lastSeen[slot] - stationarySince[slot];
+    out.stationarySeconds = stationaryTotal[slot] + out.dwellSeconds;
+    return true;
+}
+
+void MotionAnalyzer::clear()
+{
+    // Diziler korunur, sadece aktif iz sayısı sıfırlanır
+    slotOfTrack.clear();
+    count = 0;
+    lastTime = -1.0;
+    moving = 0;
+    parkedNow = 0;
+    averageSpeed = 0.0;
+}
+
+QString MotionAnalyzer::getInfo() const
+{
+    return QString("MotionAnalyzer[Active:%1, Moving:%2, Stationary:%3, Parked:%4, AvgSpeed:%5px/s, Tracks:%6, ParkedTotal:%7]")
+        .arg(count)
+        .arg(moving)
+        .arg(count - moving)
+        .arg(parkedNow)
+        .arg(averageSpeed, 0, 'f', 1)
+        .arg(trackTotal)
+        .arg(parkedTotal);
+}
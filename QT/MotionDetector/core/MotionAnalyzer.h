@@ -0,0 +1,105 @@
+#ifndef MOTIONANALYZER_H
+#define MOTIONANALYZER_H
+
+#include "ai/DetectionData.h"
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/*
+ İz (trackId) başına hız, yön, duran/hareketli durumu ve bekleme süresi hesaplayan analizci
+ Her gösterilen frame'in kutuları ve zaman damgası ile beslenir. İz durumu
+ yapı dizisi yerine dizi yapısı (SoA) olarak tutulur: her alan için ayrı
+ yoğun dizi, iz geçmişi ise iz başına HistoryLength örneklik düz halka.
+ Aktif izler dizilerin başında bitişiktir (silinen iz sonuncuyla yer değiştirir),
+ böylece update() O(nesne) çalışır ve sadece kullanılan bellek dolaşılır.
+ Kapasite aşılmadıkça frame başına bellek ayrılmaz. Hız birimi piksel/saniyedir.
+ Sadece Ana Thread'den kullanılır.
+ */
+class MotionAnalyzer {
+public:
+    static constexpr int HistoryLength = 16;
+
+    struct Config {
+        double stationarySpeed = 8.0;   // Bu hızın altına inen iz duruyor sayılır (px/s)
+        double movingSpeed = 15.0;      // Bu hızın üstüne çıkan iz hareketli sayılır (px/s)
+        double speedWindow = 0.25;      // Hız en az bu kadar saniyelik geçmişten ölçülür
+        double speedSmoothing = 0.3;    // Üstel ortalama katsayısı (1 = yumuşatma yok)
+        double parkedSeconds = 15 * 60; // Bu süreden uzun duran iz park etmiş sayılır
+        double staleSeconds = 2.0;      // Bu süre görülmeyen iz kapatılır
+        int initialCapacity = 1024;     // Önceden ayrılan iz sayısı
+    };
+
+    struct TrackMotion {
+        int trackId = -1;
+        int classId = -1;
+        double speed = 0.0;             // px/s (yumuşatılmış)
+        double heading = 0.0;           // Derece, +x ekseninden saat yönünde (görüntü koordinatı)
+        bool moving = false;
+        bool parked = false;
+        double firstSeen = 0.0;         // Saniye (video zamanı)
+        double lastSeen = 0.0;
+        double dwellSeconds = 0.0;      // Şu anki duruş süresi
+        double stationarySeconds = 0.0; // Toplam duruş süresi
+    };
+
+    MotionAnalyzer();
+    explicit MotionAnalyzer(const Config& config);
+
+    // detections içindeki izlenen kutular (trackId >= 0) timeStamp anına eklenir.
+    // Zaman geri giderse (seek, yeni video) analizci sıfırlanır.
+    void update(const DetectionResult& detections, double timeStamp);
+    bool motion(int trackId, TrackMotion& out) const;
+    void clear();
+
+    int activeCount() const { return count; }
+    int movingCount() const { return moving; }
+    int stationaryCount() const { return count - moving; }
+    int parkedCount() const { return parkedNow; }
+    quint64 totalTracks() const { return trackTotal; }
+    quint64 totalParked() const { return parkedTotal; }
+    double averageMovingSpeed() const { return averageSpeed; }
+
+    QString getInfo() const;
+
+private:
+    int slotFor(const Detection& detection, double timeStamp);
+    void grow();
+    void release(int slot);
+    void moveSlot(int from, int to);
+    void updateSlot(int slot, double cx, double cy, double timeStamp);
+
+    Config config;
+    QHash<int, int> slotOfTrack;    // trackId -> yoğun dizi indeksi
+    int count;                      // Aktif iz sayısı (dizilerin ilk count elemanı)
+    int capacity;
+    double lastTime;
+
+    // İz başına alanlar (SoA)
+    QVector<int> trackIds;
+    QVector<int> classIds;
+    QVector<double> speeds;
+    QVector<double> headings;
+    QVector<double> firstSeen;
+    QVector<double> lastSeen;
+    QVector<double> stationarySince;    // Duruyorsa duruşun başladığı an, hareketliyse -1
+    QVector<double> stationaryTotal;    // Biten duruşların toplamı
+    QVector<char> movingFlags;
+    QVector<char> parkedFlags;
+
+    // Konum geçmişi: iz başına HistoryLength örnek, slot * HistoryLength + k
+    QVector<float> historyX;
+    QVector<float> historyY;
+    QVector<double> historyT;
+    QVector<int> historyHead;           // Sonraki yazılacak konum
+    QVector<int> historySize;
+
+    // Son update() sonrası özet
+    int moving;
+    int parkedNow;
+    double averageSpeed;
+    quint64 trackTotal;
+    quint64 parkedTotal;
+};
+
+#endif // MOTIONANALYZER_H
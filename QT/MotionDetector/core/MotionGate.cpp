@@ -0,0 +1,87 @@
+#include "MotionGate.h"
+
+MotionGate::MotionGate()
+    : MotionGate(Config())
+{
+}
+
+MotionGate::MotionGate(const Config& config)
+    : config(config),
+    gateEnabled(true),
+    resetRequested(false),
+    skippedInRow(0),
+    changedRatio(0.0),
+    skippedCount(0),
+    passedCount(0)
+{
+}
+
+bool MotionGate::check(const cv::Mat& frame)
+{
+    if (resetRequested.exchange(false)) {
+        reference.release();
+        skippedInRow = 0;
+    }
+    if (!gateEnabled || frame.empty()) {
+        passedCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    makeThumbnail(frame, current);
+
+    // İlk frame, çözünürlük değişimi (yeni video) ya da uzun atlama: referans yenilenir
+    const bool mustPass = reference.empty() || reference.size() != current.size() ||
+                          skippedInRow >= config.maxSkipped;
+    double ratio = 1.0;
+    if (!mustPass) {
+        cv::absdiff(current, reference, diff);
+        cv::threshold(diff, diff, config.pixelThreshold, 255, cv::THRESH_BINARY);
+        ratio = static_cast<double>(cv::countNonZero(diff)) / diff.total();
+    }
+    changedRatio = ratio;
+
+    if (!mustPass && ratio < config.minChangedRatio) {
+        skippedInRow++;
+        skippedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    cv::swap(reference, current); // Buffer'lar yer değiştirir, kopya yapılmaz
+    skippedInRow = 0;
+    passedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MotionGate::makeThumbnail(const cv::Mat& frame, cv::Mat& out)
+{
+    // Önce küçültülür, renk dönüşümü ve bulanıklaştırma küçük görüntüde yapılır
+    const int width = qMin(config.width, frame.cols);
+    const int height = qMax(1, frame.rows * width / frame.cols);
+    cv::resize(frame, small, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+    if (small.channels() == 3) {
+        cv::cvtColor(small, gray, cv::COLOR_BGR2GRAY);
+    } else if (small.channels() == 4) {
+        cv::cvtColor(small, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        small.copyTo(gray);
+    }
+    // Sensör gürültüsü ve sıkıştırma artıkları hareket sayılmasın
+    cv::GaussianBlur(gray, out, cv::Size(5, 5), 0);
+}
+
+void MotionGate::reset()
+{
+    resetRequested = true;
+}
+
+QString MotionGate::getInfo() const
+{
+    const quint64 skippedFrames = skipped();
+    const quint64 total = skippedFrames + passed();
+    return QString("MotionGate[Enabled:%1, Passed:%2, Skipped:%3 (%4%), LastChange:%5%]")
+        .arg(gateEnabled.load() ? "Yes" : "No")
+        .arg(passed())
+        .arg(skippedFrames)
+        .arg(total > 0 ? 100.0 * skippedFrames / total : 0.0, 0, 'f', 1)
+        .arg(lastChangedRatio() * 100.0, 0, 'f', 2);
+}
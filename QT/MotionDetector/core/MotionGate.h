@@ -0,0 +1,63 @@
+#ifndef MOTIONGATE_H
+#define MOTIONGATE_H
+
+#include <QString>
+#include <opencv2/opencv.hpp>
+#include <atomic>
+
+/*
+ Tespit öncesi ucuz hareket kapısı
+ Frame küçük bir gri kopyaya indirilip son tespite gönderilen frame ile
+ karşılaştırılır (frame farkı). Değişen piksel oranı eşiğin altındaysa frame
+ tespite gönderilmez, önceki sonuçlar geçerli kalır. Yavaş değişimler de
+ birikerek eşiği aşar, çünkü referans sadece frame gönderildiğinde yenilenir.
+ Işık değişimi gibi kaymaları düzeltmek için maxSkipped atlamadan sonra frame
+ her durumda gönderilir. Tüm işlemler OpenCV'nin vektörel çekirdekleri ile
+ küçük görüntü üzerinde yapılır, ara buffer'lar tekrar kullanılır.
+ check() sadece Video Thread'den çağrılır, sayaçlar her thread'den okunabilir.
+ */
+class MotionGate {
+public:
+    struct Config {
+        int width = 160;                // Karşılaştırma genişliği (yükseklik oranla)
+        int pixelThreshold = 25;        // Bu gri seviye farkı değişmiş piksel sayılır
+        double minChangedRatio = 0.002; // Değişen piksel oranı bunun altındaysa hareket yok
+        int maxSkipped = 50;            // Art arda en fazla bu kadar frame atlanır
+    };
+
+    MotionGate();
+    explicit MotionGate(const Config& config);
+
+    // true: hareket var (ya da kapı kapalı), frame tespite gönderilmeli
+    bool check(const cv::Mat& frame);
+    void reset();
+
+    void setEnabled(bool enabled) { gateEnabled = enabled; }
+    bool isEnabled() const { return gateEnabled; }
+
+    quint64 skipped() const { return skippedCount.load(std::memory_order_relaxed); }
+    quint64 passed() const { return passedCount.load(std::memory_order_relaxed); }
+    double lastChangedRatio() const { return changedRatio.load(std::memory_order_relaxed); }
+    QString getInfo() const;
+
+private:
+    void makeThumbnail(const cv::Mat& frame, cv::Mat& out);
+
+    Config config;
+    std::atomic<bool> gateEnabled;
+    std::atomic<bool> resetRequested;
+
+    // Sadece Video Thread
+    cv::Mat small;
+    cv::Mat gray;
+    cv::Mat current;
+    cv::Mat reference;
+    cv::Mat diff;
+    int skippedInRow;
+
+    std::atomic<double> changedRatio;
+    std::atomic<quint64> skippedCount;
+    std::atomic<quint64> passedCount;
+};
+
+#endif // MOTIONGATE_H
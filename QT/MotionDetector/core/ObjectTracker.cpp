@@ -0,0 +1,297 @@
+#include "ObjectTracker.h"
+#include <QDebug>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double Forbidden = 1.0e6; // Eşleşmesine izin verilmeyen çiftin maliyeti
+
+double intersectionOverUnion(const cv::Rect& a, const cv::Rect& b)
+{
+    const double intersection = (a & b).area();
+    const double unionArea = a.area() + b.area() - intersection;
+    return unionArea > 0 ? intersection / unionArea : 0.0;
+}
+
+/*
+ Macar algoritması (potansiyelli, O(n^2 m)). cost n x m, n <= m olmalıdır.
+ Dönen dizide i. satıra atanan sütun bulunur.
+ */
+QVector<int> solveAssignment(const QVector<QVector<double>>& cost, int columns)
+{
+    const int rows = cost.size();
+    const double infinity = std::numeric_limits<double>::infinity();
+    QVector<double> u(rows + 1, 0.0), v(columns + 1, 0.0);
+    QVector<int> owner(columns + 1, 0), way(columns + 1, 0);
+
+    for (int i = 1; i <= rows; ++i) {
+        owner[0] = i;
+        int j0 = 0;
+        QVector<double> minv(columns + 1, infinity);
+        QVector<bool> used(columns + 1, false);
+        do {
+            used[j0] = true;
+            const int i0 = owner[j0];
+            double delta = infinity;
+            int j1 = 0;
+            for (int j = 1; j <= columns; ++j) {
+                if (used[j]) continue;
+                const double current = cost[i0 - 1][j - 1] - u[i0] - v[j];
+                if (current < minv[j]) {
+                    minv[j] = current;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= columns; ++j) {
+                if (used[j]) {
+                    u[owner[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (owner[j0] != 0);
+
+        do {
+            const int j1 = way[j0];
+            owner[j0] = owner[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    QVector<int> assignment(rows, -1);
+    for (int j = 1; j <= columns; ++j) {
+        if (owner[j] > 0) assignment[owner[j] - 1] = j - 1;
+    }
+    return assignment;
+}
+
+} // namespace
+
+void ObjectTracker::AxisFilter::init(double z, double r)
+{
+    p = z;
+    v = 0.0;
+    p00 = r;
+    p01 = 0.0;
+    p11 = 25.0; // Başlangıç hızı bilinmiyor (~5 piksel/frame standart sapma)
+}
+
+void ObjectTracker::AxisFilter::predict(double dt, double q)
+{
+    // P = F P F^T + Q, F = [[1, dt], [0, 1]], Q sürekli beyaz ivme modeli
+    p += v * dt;
+    p00 += 2.0 * dt * p01 + dt * dt * p11 + q * dt * dt * dt / 3.0;
+    p01 += dt * p11 + q * dt * dt / 2.0;
+    p11 += q * dt;
+}
+
+void ObjectTracker::AxisFilter::correct(double z, double r)
+{
+    const double s = p00 + r;
+    const double k0 = p00 / s;
+    const double k1 = p01 / s;
+    const double innovation = z - p;
+    p += k0 * innovation;
+    v += k1 * innovation;
+    p11 -= k1 * p01;
+    p00 *= (1.0 - k0);
+    p01 *= (1.0 - k0);
+}
+
+ObjectTracker::ObjectTracker()
+    : ObjectTracker(Config())
+{
+}
+
+ObjectTracker::ObjectTracker(const Config& config)
+    : config(config),
+    nextTrackId(1),
+    lastFrameId(-1),
+    createdCount(0),
+    matchedCount(0),
+    lostCount(0)
+{
+}
+
+DetectionResult ObjectTracker::update(const DetectionResult& result)
+{
+    DetectionResult tracked = result;
+    if (!result.isValid()) {
+        return tracked;
+    }
+
+    if (lastFrameId >= 0 && result.frameId < lastFrameId) {
+        qDebug() << "ObjectTracker: Eski frameId geldi, takipçi sıfırlanıyor:" << result.frameId;
+        clear();
+    }
+
+    // İzler sonuç frame'ine taşınır
+    QVector<cv::Rect> predicted(tracks.size());
+    for (int i = 0; i < tracks.size(); ++i) {
+        Track& track = tracks[i];
+        const double dt = result.frameId - track.frameId;
+        for (int axis = 0; axis < 4; ++axis) {
+            track.axes[axis].predict(dt, axis < 2 ? config.positionNoise : config.sizeNoise);
+        }
+        track.frameId = result.frameId;
+        predicted[i] = boxAt(track, result.frameId);
+    }
+
+    // Maliyet matrisi kare yapılır, boş satır/sütunlar "eşleşmedi" anlamına gelir
+    const int trackCount = tracks.size();
+    const int detectionCount = tracked.detections.size();
+    const int size = qMax(trackCount, detectionCount);
+    QVector<int> trackForDetection(detectionCount, -1);
+
+    if (trackCount > 0 && detectionCount > 0) {
+        QVector<QVector<double>> cost(size, QVector<double>(size, Forbidden));
+        for (int i = 0; i < trackCount; ++i) {
+            for (int j = 0; j < detectionCount; ++j) {
+                cost[i][j] = associationCost(predicted[i], tracked.detections[j], tracks[i].classId);
+            }
+        }
+
+        const QVector<int> assignment = solveAssignment(cost, size);
+        for (int i = 0; i < trackCount; ++i) {
+            const int j = assignment[i];
+            if (j >= 0 && j < detectionCount && cost[i][j] < Forbidden) {
+                trackForDetection[j] = i;
+            }
+        }
+    }
+
+    QVector<bool> matched(trackCount, false);
+    for (int j = 0; j < detectionCount; ++j) {
+        const int i = trackForDetection[j];
+        if (i < 0) continue;
+
+        Track& track = tracks[i];
+        const Detection& detection = tracked.detections[j];
+        const cv::Rect& box = detection.bbox;
+        const double measurement[4] = {
+            box.x + box.width / 2.0, box.y + box.height / 2.0,
+            static_cast<double>(box.width), static_cast<double>(box.height)
+        };
+        for (int axis = 0; axis < 4; ++axis) {
+            track.axes[axis].correct(measurement[axis], config.measurementNoise);
+        }
+        track.confidence = detection.confidence;
+        track.className = detection.className;
+        track.hits++;
+        track.missed = 0;
+        matched[i] = true;
+        tracked.detections[j].trackId = track.id;
+        matchedCount++;
+    }
+
+    // Görülmeyen izler yaşlanır, süresi dolanlar silinir
+    for (int i = trackCount - 1; i >= 0; --i) {
+        if (matched[i]) continue;
+        if (++tracks[i].missed > config.maxMissedUpdates) {
+            tracks.removeAt(i);
+            lostCount++;
+        }
+    }
+
+    for (int j = 0; j < detectionCount; ++j) {
+        if (trackForDetection[j] < 0 && tracked.detections[j].isValid()) {
+            startTrack(tracked.detections[j], result.frameId);
+        }
+    }
+
+    lastFrameId = result.frameId;
+    return tracked;
+}
+
+bool ObjectTracker::predict(int frameId, DetectionResult& out) const
+{
+    out = DetectionResult();
+    out.frameId = lastFrameId;
+    out.success = true;
+
+    for (const Track& track : tracks) {
+        if (track.missed > 0) continue; // Son turda görülmeyen iz sadece kimlik için tutulur
+
+        Detection detection;
+        detection.classId = track.classId;
+        detection.className = track.className;
+        detection.confidence = track.confidence;
+        detection.bbox = boxAt(track, frameId);
+        detection.trackId = track.id;
+        out.detections.append(detection);
+    }
+    return !out.detections.isEmpty();
+}
+
+void ObjectTracker::clear()
+{
+    tracks.clear();
+    lastFrameId = -1;
+}
+
+void ObjectTracker::startTrack(Detection& detection, int frameId)
+{
+    Track track;
+    track.id = nextTrackId++;
+    track.classId = detection.classId;
+    track.className = detection.className;
+    track.confidence = detection.confidence;
+    track.frameId = frameId;
+    track.hits = 1;
+
+    const cv::Rect& box = detection.bbox;
+    track.axes[0].init(box.x + box.width / 2.0, config.measurementNoise);
+    track.axes[1].init(box.y + box.height / 2.0, config.measurementNoise);
+    track.axes[2].init(box.width, config.measurementNoise);
+    track.axes[3].init(box.height, config.measurementNoise);
+
+    detection.trackId = track.id;
+    tracks.append(track);
+    createdCount++;
+}
+
+cv::Rect ObjectTracker::boxAt(const Track& track, int frameId)
+{
+    const double dt = frameId - track.frameId;
+    const double width = qMax(1.0, track.axes[2].at(dt));
+    const double height = qMax(1.0, track.axes[3].at(dt));
+    return cv::Rect(static_cast<int>(std::lround(track.axes[0].at(dt) - width / 2.0)),
+                    static_cast<int>(std::lround(track.axes[1].at(dt) - height / 2.0)),
+                    static_cast<int>(std::lround(width)),
+                    static_cast<int>(std::lround(height)));
+}
+
+double ObjectTracker::associationCost(const cv::Rect& predicted, const Detection& detection, int trackClass) const
+{
+    if (detection.classId != trackClass || !detection.isValid()) {
+        return Forbidden;
+    }
+
+    // Seyrek tespitte hızlı nesnelerin kutuları örtüşmeyebilir, merkez yakınlığı da kabul edilir
+    const double iou = intersectionOverUnion(predicted, detection.bbox);
+    const double dx = (predicted.x + predicted.width / 2.0) - (detection.bbox.x + detection.bbox.width / 2.0);
+    const double dy = (predicted.y + predicted.height / 2.0) - (detection.bbox.y + detection.bbox.height / 2.0);
+    const double diagonal = std::hypot(predicted.width, predicted.height);
+    const double shift = diagonal > 0 ? std::hypot(dx, dy) / diagonal : 1.0;
+
+    if (iou < config.iouThreshold && shift > config.maxCenterShift) {
+        return Forbidden;
+    }
+    return (1.0 - iou) + shift;
+}
+
+QString ObjectTracker::getInfo() const
+{
+    return QString("ObjectTracker[Active:%1, Created:%2, Matched:%3, Lost:%4]")
+        .arg(tracks.size())
+        .arg(createdCount)
+        .arg(matchedCount)
+        .arg(lostCount);
+}
@@ -0,0 +1,86 @@
+#ifndef OBJECTTRACKER_H
+#define OBJECTTRACKER_H
+
+#include "ai/DetectionData.h"
+#include <QString>
+#include <QVector>
+
+/*
+ Seyrek tespitler arasında nesne kimliklerini taşıyan çoklu nesne takipçisi (SORT benzeri)
+ Her iz kutu merkezi ve boyutu için sabit hızlı Kalman filtresi tutar (eksen
+ başına bağımsız konum + hız). Yeni tespit geldiğinde izler o frame'e tahmin
+ edilir, izler ile tespitler IoU maliyeti üzerinden Macar algoritması ile
+ eşleştirilir. Eşleşen tespitler izin kimliğini (trackId) alır, eşleşmeyenler
+ yeni iz açar, art arda görülmeyen izler silinir.
+ Zaman birimi frameId'dir; predict() herhangi bir frame için durumu değiştirmeden
+ kutuları tahmin eder. Sadece Ana Thread'den kullanılır.
+ */
+class ObjectTracker {
+public:
+    struct Config {
+        double iouThreshold = 0.3;      // Bu değerin altı farklı nesne sayılır...
+        double maxCenterShift = 0.5;    // ...merkez kayması kutu köşegeninin bu oranından küçük değilse
+        int maxMissedUpdates = 2;       // Bu kadar tespit turu görülmeyen iz silinir
+        double positionNoise = 0.5;     // Merkez süreç gürültüsü (piksel^2 / frame^3)
+        double sizeNoise = 0.1;         // Genişlik/yükseklik süreç gürültüsü
+        double measurementNoise = 16.0; // Tespit kutusu ölçüm gürültüsü (piksel^2)
+    };
+
+    ObjectTracker();
+    explicit ObjectTracker(const Config& config);
+
+    // Sonucu izlerle eşleştirir, tespitlere trackId atanmış kopyasını döner.
+    // Daha eski bir frameId gelirse (yeni video, seek) takipçi sıfırlanır.
+    DetectionResult update(const DetectionResult& result);
+
+    // frameId için son turda görülen izlerin tahmini kutuları. out.frameId son
+    // güncellemenin frameId'sidir. Gösterilecek iz yoksa false döner.
+    bool predict(int frameId, DetectionResult& out) const;
+
+    void clear();
+
+    int activeTracks() const { return tracks.size(); }
+    int lastUpdateFrameId() const { return lastFrameId; }
+    QString getInfo() const;
+
+private:
+    // Tek eksen için sabit hız modeli: durum (p, v), kovaryans [[p00, p01], [p01, p11]]
+    struct AxisFilter {
+        double p = 0.0;
+        double v = 0.0;
+        double p00 = 0.0;
+        double p01 = 0.0;
+        double p11 = 0.0;
+
+        void init(double z, double r);
+        void predict(double dt, double q);
+        void correct(double z, double r);
+        double at(double dt) const { return p + v * dt; }
+    };
+
+    struct Track {
+        int id = -1;
+        int classId = -1;
+        QString className;
+        double confidence = 0.0;
+        AxisFilter axes[4];     // Merkez x, merkez y, genişlik, yükseklik
+        int frameId = -1;       // Filtrelerin geçerli olduğu frame
+        int hits = 0;
+        int missed = 0;
+    };
+
+    void startTrack(Detection& detection, int frameId);
+    static cv::Rect boxAt(const Track& track, int frameId);
+    double associationCost(const cv::Rect& predicted, const Detection& detection, int trackClass) const;
+
+    Config config;
+    QVector<Track> tracks;
+    int nextTrackId;
+    int lastFrameId;
+
+    quint64 createdCount;
+    quint64 matchedCount;
+    quint64 lostCount;
+};
+
+#endif // OBJECTTRACKER_H
@@ -0,0 +1,81 @@
+#include "PresentationClock.h"
+
+PresentationClock::PresentationClock()
+    : anchorWall(0.0),
+    anchorMedia(0.0),
+    playbackRate(1.0),
+    started(false),
+    paused(false)
+{
+    monotonic.start();
+}
+
+double PresentationClock::wallSeconds() const
+{
+    return monotonic.nsecsElapsed() / 1.0e9;
+}
+
+void PresentationClock::start(double mediaTime)
+{
+    anchorWall = wallSeconds();
+    anchorMedia = mediaTime;
+    started = true;
+    paused = false;
+}
+
+void PresentationClock::reset()
+{
+    started = false;
+    paused = false;
+    anchorMedia = 0.0;
+}
+
+void PresentationClock::pause()
+{
+    if (!started || paused) {
+        return;
+    }
+    anchorMedia = mediaTime();
+    paused = true;
+}
+
+void PresentationClock::resume()
+{
+    if (!started || !paused) {
+        return;
+    }
+    anchorWall = wallSeconds();
+    paused = false;
+}
+
+void PresentationClock::setRate(double rate)
+{
+    if (rate <= 0.0) {
+        return;
+    }
+    // Çapayı şimdiye taşı ki hız değişimi video zamanında sıçrama yapmasın
+    anchorMedia = mediaTime();
+    anchorWall = wallSeconds();
+    playbackRate = rate;
+}
+
+double PresentationClock::mediaTime() const
+{
+    if (!started || paused) {
+        return anchorMedia;
+    }
+    return anchorMedia + (wallSeconds() - anchorWall) * playbackRate;
+}
+
+double PresentationClock::msUntil(double timeStamp) const
+{
+    return (timeStamp - mediaTime()) * 1000.0 / playbackRate;
+}
+
+QString PresentationClock::getInfo() const
+{
+    return QString("Clock[Time:%1s, Rate:%2x, %3]")
+        .arg(mediaTime(), 0, 'f', 3)
+        .arg(playbackRate, 0, 'f', 2)
+        .arg(!started ? "Stopped" : (paused ? "Paused" : "Running"));
+}
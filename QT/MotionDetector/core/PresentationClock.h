@@ -0,0 +1,50 @@
+#ifndef PRESENTATIONCLOCK_H
+#define PRESENTATIONCLOCK_H
+
+#include <QElapsedTimer>
+#include <QString>
+
+/*
+ Frame'leri timeStamp'lerine (PTS, saniye) göre gösterme saati
+ Monoton bir saat ile video zamanı arasında bir çapa (anchor) tutulur:
+   videoZamanı = çapaVideo + (şimdi - çapaDuvar) * hız
+ Hız değiştiğinde ya da duraklatıldığında çapa o anki video zamanına taşınır,
+ böylece oynatma sıçramadan devam eder. Sadece Ana Thread'den kullanılır.
+ */
+class PresentationClock {
+public:
+    PresentationClock();
+
+    // Saati verilen video zamanından başlatır (ilk frame ya da seek sonrası)
+    void start(double mediaTime);
+    void reset();
+    bool isStarted() const { return started; }
+
+    void pause();
+    void resume();
+    bool isPaused() const { return paused; }
+
+    // Oynatma hızı (1.0 = normal), geçerli video zamanı korunur
+    void setRate(double rate);
+    double rate() const { return playbackRate; }
+
+    // Şu anki video zamanı (saniye)
+    double mediaTime() const;
+
+    // timeStamp'li frame'in gösterilmesine kalan süre (ms), negatifse frame gecikmiş
+    double msUntil(double timeStamp) const;
+
+    QString getInfo() const;
+
+private:
+    double wallSeconds() const;
+
+    QElapsedTimer monotonic;
+    double anchorWall;      // Çapanın monoton saatteki zamanı (s)
+    double anchorMedia;     // Çapanın video zamanı (s)
+    double playbackRate;
+    bool started;
+    bool paused;
+};
+
+#endif // PRESENTATIONCLOCK_H
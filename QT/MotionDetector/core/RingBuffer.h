@@ -0,0 +1,333 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QString>
+
+/*
+ Lock-free sınırlı halka kuyruklar
+ SpscRing: tek üretici / tek tüketici, en hızlı yol (sadece iki atomik indeks)
+ MpmcRing: çok üretici / çok tüketici (Vyukov tipi sıra numaralı hücreler)
+
+ Push/pop işlemleri kilit almaz. Kilit sadece pop_for() ile gerçekten uyuyan
+ bir tüketici varsa onu uyandırmak için kullanılır, normal akışta dokunulmaz.
+ Elemanlar taşınarak (move) eklenir ve çıkarılır, kuyruk içinde kopya yapılmaz.
+ */
+
+namespace ringdetail {
+
+constexpr size_t CacheLine = 64;
+
+inline size_t roundUpPow2(size_t value)
+{
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Boş kuyrukta bekleyen tüketiciler için uyandırma mekanizması
+class Waiter {
+public:
+    // Üretici her başarılı push tan sonra çağırır. Bekleyen yoksa kilit alınmaz.
+    void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            condition.notify_all();
+        }
+    }
+
+    // tryPop başarılı olana ya da süre dolana kadar bekler
+    template<typename TryPop>
+    bool waitFor(TryPop tryPop, std::chrono::milliseconds timeout)
+    {
+        // Kısa bir spin ile çoğu durumda uyumadan eleman yakalanır
+        for (int i = 0; i < 64; ++i) {
+            if (tryPop()) return true;
+            std::this_thread::yield();
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> lock(mutex);
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool popped = tryPop();
+        while (!popped) {
+            if (condition.wait_until(lock, deadline) == std::cv_status::timeout) {
+                popped = tryPop();
+                break;
+            }
+            popped = tryPop();
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return popped;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<int> waiters{0};
+};
+
+} // namespace ringdetail
+
+/*
+ Tek üretici / tek tüketici halka kuyruk
+ try_push sadece üretici thread'den, try_pop/pop_for/clear sadece tüketici
+ thread'den çağrılmalıdır. Doluyken push() yeni elemanı düşürür ve sayar.
+ */
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity = 50)
+        : maxSize(capacity > 0 ? capacity : 1),
+        slots(maxSize + 1)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    bool try_push(T&& item)
+    {
+        const size_t tail = tailIndex.load(std::memory_order_relaxed);
+        const size_t next = increment(tail);
+        if (next == headCache) {
+            headCache = headIndex.load(std::memory_order_acquire);
+            if (next == headCache) return false;
+        }
+        slots[tail] = std::move(item);
+        tailIndex.store(next, std::memory_order_release);
+        pushedCount.fetch_add(1, std::memory_order_relaxed);
+        waiter.notify();
+        return true;
+    }
+
+    // Doluysa yeni eleman düşürülür
+    bool push(T&& item)
+    {
+        if (try_push(std::move(item))) return true;
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool try_pop(T& out)
+    {
+        const size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailCache) {
+            tailCache = tailIndex.load(std::memory_order_acquire);
+            if (head == tailCache) return false;
+        }
+        out = std::move(slots[head]);
+        slots[head] = T(); // Kaynakları (örn. havuz slab'ı) hemen bırak
+        headIndex.store(increment(head), std::memory_order_release);
+        poppedCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool pop_for(T& out, std::chrono::milliseconds timeout)
+    {
+        return waiter.waitFor([&] { return try_pop(out); }, timeout);
+    }
+
+    void clear()
+    {
+        T discarded;
+        while (try_pop(discarded)) {}
+    }
+
+    size_t size() const
+    {
+        const size_t head = headIndex.load(std::memory_order_acquire);
+        const size_t tail = tailIndex.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + slots.size() - head;
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return maxSize; }
+
+    quint64 pushed() const { return pushedCount.load(std::memory_order_relaxed); }
+    quint64 popped() const { return poppedCount.load(std::memory_order_relaxed); }
+    quint64 dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    QString getInfo() const
+    {
+        return QString("SpscRing[Size:%1/%2, Pushed:%3, Popped:%4, Dropped:%5]")
+            .arg(size()).arg(maxSize).arg(pushed()).arg(popped()).arg(dropped());
+    }
+
+private:
+    size_t increment(size_t index) const
+    {
+        return ++index == slots.size() ? 0 : index;
+    }
+
+    const size_t maxSize;
+    std::vector<T> slots;
+
+    alignas(ringdetail::CacheLine) std::atomic<size_t> headIndex{0};  // Tüketici yazar
+    size_t tailCache = 0;                                              // Tüketicinin gördüğü son tail
+    alignas(ringdetail::CacheLine) std::atomic<size_t> tailIndex{0};  // Üretici yazar
+    size_t headCache = 0;                                              // Üreticinin gördüğü son head
+
+    alignas(ringdetail::CacheLine) std::atomic<quint64> pushedCount{0};
+    std::atomic<quint64> poppedCount{0};
+    std::atomic<quint64> droppedCount{0};
+    ringdetail::Waiter waiter;
+};
+
+/*
+ Çok üretici / çok tüketici halka kuyruk (Dmitry Vyukov'un sınırlı kuyruğu)
+ Her hücre kendi sıra numarasını taşır, üreticiler ve tüketiciler yalnızca
+ kendi indeksleri üzerinde CAS yapar. Kapasite 2'nin kuvvetine yuvarlanır.
+ Doluyken push() en eski elemanı düşürür (eski ThreadQueue davranışı).
+ */
+template<typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t capacity = 50)
+        : maxSize(capacity > 0 ? capacity : 1),
+        mask(ringdetail::roundUpPow2(maxSize) - 1),
+        cells(mask + 1)
+    {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    bool try_push(T&& item)
+    {
+        Cell* cell = nullptr;
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // Mantıksal kapasite fiziksel hücre sayısından küçük olabilir. Sınır,
+                // hücreyi alacak pozisyona göre denetlenir: CAS bu pozisyonu tek bir
+                // üreticiye verdiği için birden fazla üretici kapasiteyi aşamaz
+                if (pos - dequeuePos.load(std::memory_order_acquire) >= maxSize) {
+                    return false;
+                }
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Dolu
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        pushedCount.fetch_add(1, std::memory_order_relaxed);
+        waiter.notify();
+        return true;
+    }
+
+    // Doluysa en eski eleman atılır ve yer açılır
+    void push(T&& item)
+    {
+        T discarded;
+        while (!try_push(std::move(item))) {
+            if (try_pop(discarded, false)) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& out)
+    {
+        return try_pop(out, true);
+    }
+
+    bool pop_for(T& out, std::chrono::milliseconds timeout)
+    {
+        return waiter.waitFor([&] { return try_pop(out); }, timeout);
+    }
+
+    // Eleman gelene kadar bekler (eski ThreadQueue::pop uyumluluğu)
+    T pop()
+    {
+        T result;
+        while (!pop_for(result, std::chrono::milliseconds(100))) {}
+        return result;
+    }
+
+    void clear()
+    {
+        T discarded;
+        while (try_pop(discarded, false)) {}
+    }
+
+    size_t size() const
+    {
+        const size_t enq = enqueuePos.load(std::memory_order_acquire);
+        const size_t deq = dequeuePos.load(std::memory_order_acquire);
+        return enq > deq ? enq - deq : 0;
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return maxSize; }
+
+    quint64 pushed() const { return pushedCount.load(std::memory_order_relaxed); }
+    quint64 popped() const { return poppedCount.load(std::memory_order_relaxed); }
+    quint64 dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    QString getInfo() const
+    {
+        return QString("Queue[Size:%1/%2, Pushed:%3, Popped:%4, Dropped:%5]")
+            .arg(size()).arg(maxSize).arg(pushed()).arg(popped()).arg(dropped());
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T data;
+    };
+
+    bool try_pop(T& out, bool countPop)
+    {
+        Cell* cell = nullptr;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Boş
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->data);
+        cell->data = T(); // Kaynakları (örn. havuz slab'ı) hemen bırak
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        if (countPop) poppedCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    const size_t maxSize;
+    const size_t mask;
+    std::vector<Cell> cells;
+
+    alignas(ringdetail::CacheLine) std::atomic<size_t> enqueuePos{0};
+    alignas(ringdetail::CacheLine) std::atomic<size_t> dequeuePos{0};
+
+    alignas(ringdetail::CacheLine) std::atomic<quint64> pushedCount{0};
+    std::atomic<quint64> poppedCount{0};
+    std::atomic<quint64> droppedCount{0};
+    ringdetail::Waiter waiter;
+};
+
+#endif // RINGBUFFER_H
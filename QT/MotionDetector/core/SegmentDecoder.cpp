@@ -0,0 +1,222 @@
+#include "SegmentDecoder.h"
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+
+// Decoder thread sayısı parametresi OpenCV 4.7 ile geldi. Daha eski sürümlerde keyframe
+// index'i de olmadığı için eşit aralıklı segmentlere dönülür.
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 7)
+#define SEGMENT_DECODER_HAS_CAP_PARAMS 1
+#endif
+
+SegmentDecoder::SegmentDecoder(const QString& filePath, FramePool* framePool,
+                               int workerCount, size_t reorderCapacity)
+    : filePath(filePath),
+    framePool(framePool),
+    requestedWorkers(workerCount),
+    reorderCapacity(reorderCapacity > 0 ? reorderCapacity : 1),
+    stopping(false),
+    currentSegment(0),
+    nextFrameId(0),
+    keyframeCount(0)
+{
+}
+
+SegmentDecoder::~SegmentDecoder()
+{
+    stop();
+}
+
+void SegmentDecoder::setFrameIndex(std::shared_ptr<const FrameIndex> index)
+{
+    frameIndex = std::move(index);
+}
+
+QVector<VideoSegment> SegmentDecoder::planSegments(const QVector<int>& keyframes, int totalFrames,
+                                                   int segmentCount)
+{
+    QVector<VideoSegment> result;
+    if (totalFrames <= 0 || segmentCount <= 1) {
+        result.append(VideoSegment());
+        return result;
+    }
+
+    const int targetLength = (totalFrames + segmentCount - 1) / segmentCount;
+    int start = 0;
+    if (!keyframes.isEmpty()) {
+        // Sınırlar sadece keyframe'lere konur, böylece her worker seek sonrası
+        // önceki GOP'u boşuna decode etmez
+        for (int keyframe : keyframes) {
+            if (keyframe < totalFrames && keyframe - start >= targetLength) {
+                result.append({start, keyframe});
+                start = keyframe;
+            }
+        }
+    } else {
+        for (int boundary = targetLength; boundary < totalFrames; boundary += targetLength) {
+            result.append({start, boundary});
+            start = boundary;
+        }
+    }
+
+    // Frame sayısı metadata'dan geldiği için son segment dosya sonuna kadar okunur
+    result.append({start, -1});
+    return result;
+}
+
+bool SegmentDecoder::start(int totalFrames, int startFrame)
+{
+    stop();
+
+    const FrameIndex index = (frameIndex && frameIndex->isValid())
+                                 ? *frameIndex : FrameIndex::loadOrBuild(filePath);
+    const QVector<int> keyframes = index.keyframeNumbers();
+    keyframeCount = keyframes.size();
+    if (index.frameCount() > 0) {
+        totalFrames = index.frameCount(); // Paket sayısı metadata'daki frame sayısından güvenilir
+    }
+    if (totalFrames <= 0) {
+        return false;
+    }
+
+    int count = requestedWorkers;
+    if (count <= 0) {
+        // Bir çekirdek birleştirme ve tüketiciler için bırakılır
+        const int cores = static_cast<int>(std::thread::hardware_concurrency());
+        count = qBound(1, cores - 1, 8);
+    }
+
+    // Worker başına birkaç segment: yük dengelenir ve sıradaki segment beklenirken
+    // diğer worker'lar ileride decode etmeye devam eder
+    segments = planSegments(keyframes, totalFrames, count * 4);
+
+    // Kaldığı yerden devam: bitmiş segmentler atlanır, ilk segment startFrame'den başlar
+    while (segments.size() > 1 && segments.first().endFrame >= 0 &&
+           segments.first().endFrame <= startFrame) {
+        segments.removeFirst();
+    }
+    segments.first().startFrame = qMax(segments.first().startFrame, startFrame);
+    count = qMin(count, static_cast<int>(segments.size()));
+
+    stopping = false;
+    currentSegment = 0;
+    nextFrameId = 0;
+
+    // Thread'ler worker listesine eriştiği için önce tüm halkalar oluşturulur
+    workers.resize(count);
+    for (Worker& worker : workers) {
+        worker.output = std::make_unique<SpscRing<FrameData>>(reorderCapacity);
+    }
+    for (int i = 0; i < count; ++i) {
+        workers[i].thread = std::thread(&SegmentDecoder::workerLoop, this, i);
+    }
+
+    qDebug() << "SegmentDecoder: Başladı," << getInfo();
+    return true;
+}
+
+void SegmentDecoder::stop()
+{
+    stopping = true;
+    for (Worker& worker : workers) {
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+    }
+    workers.clear(); // Halkalarda kalan frame'ler havuza döner
+}
+
+bool SegmentDecoder::pushToOutput(SpscRing<FrameData>& output, FrameData&& frameData)
+{
+    // Halka doluysa tüketici bu worker'ın segmentine gelene kadar bekle
+    while (!stopping) {
+        if (output.try_push(std::move(frameData))) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+void SegmentDecoder::workerLoop(int workerIndex)
+{
+    SpscRing<FrameData>& output = *workers[workerIndex].output;
+
+#ifdef SEGMENT_DECODER_HAS_CAP_PARAMS
+    // Paralellik segmentlerden gelir, decoder'ın kendi thread'leri çekirdekleri aşırı doldurur
+    cv::VideoCapture capture(filePath.toStdString(), cv::CAP_ANY, {cv::CAP_PROP_N_THREADS, 1});
+#else
+    cv::VideoCapture capture(filePath.toStdString());
+#endif
+    if (!capture.isOpened()) {
+        qDebug() << "SegmentDecoder: Worker" << workerIndex << "videoyu açamadı";
+    }
+    const int width = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    const int height = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+
+    const int stride = static_cast<int>(workers.size());
+    for (int s = workerIndex; s < segments.size() && !stopping; s += stride) {
+        const VideoSegment& segment = segments[s];
+        if (capture.isOpened()) {
+            capture.set(cv::CAP_PROP_POS_FRAMES, segment.startFrame);
+
+            int position = segment.startFrame;
+            while (!stopping && (segment.endFrame < 0 || position < segment.endFrame)) {
+                cv::Mat frame = framePool ? framePool->acquire(height, width, CV_8UC3) : cv::Mat();
+                const uchar* pooledData = frame.data;
+                if (!capture.read(frame) || frame.empty()) {
+                    break;
+                }
+                if (framePool && pooledData && frame.data != pooledData) {
+                    framePool->reportReallocation();
+                }
+
+                FrameData frameData;
+                frameData.frameNumber = position++;
+                frameData.timeStamp = capture.get(cv::CAP_PROP_POS_MSEC) / 1000.0;
+                frameData.frame = frame;
+                if (!pushToOutput(output, std::move(frameData))) {
+                    return;
+                }
+            }
+        }
+
+        // Segment sonu işareti (boş frame). Açılamayan worker da işaret koyar ki
+        // birleştirme bu segmentte takılı kalmasın.
+        if (!pushToOutput(output, FrameData())) {
+            return;
+        }
+    }
+}
+
+bool SegmentDecoder::next(FrameData& out, const std::atomic<bool>& running)
+{
+    while (running && currentSegment < segments.size()) {
+        // Segment s, s % workerCount numaralı worker'ın halkasından sırayla gelir
+        SpscRing<FrameData>& output = *workers[currentSegment % workers.size()].output;
+
+        FrameData frameData;
+        if (!output.pop_for(frameData, std::chrono::milliseconds(100))) {
+            continue;
+        }
+        if (frameData.frame.empty()) {
+            ++currentSegment;
+            continue;
+        }
+
+        frameData.frameId = nextFrameId++;
+        out = std::move(frameData);
+        return true;
+    }
+    return false;
+}
+
+QString SegmentDecoder::getInfo() const
+{
+    return QString("SegmentDecoder[Workers:%1, Segments:%2/%3, Keyframes:%4, Frames:%5]")
+        .arg(workers.size())
+        .arg(currentSegment)
+        .arg(segments.size())
+        .arg(keyframeCount)
+        .arg(nextFrameId);
+}
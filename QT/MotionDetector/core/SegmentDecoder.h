@@ -0,0 +1,87 @@
+#ifndef SEGMENTDECODER_H
+#define SEGMENTDECODER_H
+
+#include "core/FrameData.h"
+#include "core/FrameIndex.h"
+#include "core/FramePool.h"
+#include "core/RingBuffer.h"
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*
+ Uzun kayıtların offline analizi için segment paralel decode
+ Video keyframe sınırlarından segmentlere bölünür, her worker kendi
+ cv::VideoCapture'ı ile kendi segmentlerini ayrı bir çekirdekte decode eder.
+ Segmentler worker'lara sırayla (round-robin) dağıtılır, her worker'ın çıkışı
+ sınırlı bir SpscRing'dir. next() segmentleri sırayla okuyarak frame'leri tekrar
+ dosya sırasına dizer, böylece tüketiciler monoton artan frameId akışı görür.
+ Bellek kullanımı worker sayısı x reorderCapacity frame ile sınırlıdır.
+ */
+
+// [startFrame, endFrame) aralığı, endFrame < 0 ise dosya sonuna kadar
+struct VideoSegment {
+    int startFrame = 0;
+    int endFrame = -1;
+};
+
+class SegmentDecoder {
+public:
+    // workerCount <= 0 ise çekirdek sayısına göre seçilir
+    explicit SegmentDecoder(const QString& filePath, FramePool* framePool = nullptr,
+                            int workerCount = 0, size_t reorderCapacity = 8);
+    ~SegmentDecoder();
+
+    SegmentDecoder(const SegmentDecoder&) = delete;
+    SegmentDecoder& operator=(const SegmentDecoder&) = delete;
+
+    // Keyframe'leri kullanarak videoyu yaklaşık segmentCount parçaya böler.
+    // Keyframe bilgisi yoksa eşit aralıklarla bölünür (seek daha pahalı olur).
+    static QVector<VideoSegment> planSegments(const QVector<int>& keyframes, int totalFrames,
+                                              int segmentCount);
+
+    // Hazır bir index verilirse start() dosyayı tekrar taramaz
+    void setFrameIndex(std::shared_ptr<const FrameIndex> index);
+
+    // Keyframe index'ini çıkarır ve worker'ları başlatır.
+    // startFrame > 0 ise decode o frame'den devam eder (duraklatma sonrası).
+    bool start(int totalFrames, int startFrame = 0);
+    void stop();
+
+    // Sıradaki frame'i dosya sırasıyla döndürür. Video bittiğinde ya da
+    // running false olduğunda false döner. Tek bir tüketici thread'den çağrılmalı.
+    bool next(FrameData& out, const std::atomic<bool>& running);
+
+    int workerCount() const { return static_cast<int>(workers.size()); }
+    int segmentCount() const { return segments.size(); }
+    QString getInfo() const;
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::unique_ptr<SpscRing<FrameData>> output;
+    };
+
+    void workerLoop(int workerIndex);
+    bool pushToOutput(SpscRing<FrameData>& output, FrameData&& frameData);
+
+    QString filePath;
+    FramePool* framePool;
+    std::shared_ptr<const FrameIndex> frameIndex;
+    int requestedWorkers;
+    size_t reorderCapacity;
+
+    QVector<VideoSegment> segments;
+    std::vector<Worker> workers;
+    std::atomic<bool> stopping;
+
+    // Birleştirme durumu (sadece tüketici thread)
+    int currentSegment;
+    int nextFrameId;
+    int keyframeCount;
+};
+
+#endif // SEGMENTDECODER_H
@@ -0,0 +1,141 @@
+#include "VideoPreloader.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+
+VideoPreloader::VideoPreloader(FramePool* framePool)
+    : framePool(framePool),
+    cancelRequested(false),
+    ready(false),
+    succeeded(false)
+{
+}
+
+VideoPreloader::~VideoPreloader()
+{
+    cancel();
+}
+
+void VideoPreloader::start(const QString& filePath, int frameCount)
+{
+    cancel();
+
+    std::lock_guard<std::mutex> lock(threadMutex);
+    {
+        std::lock_guard<std::mutex> resultLock(mutex);
+        path = filePath;
+        succeeded = false;
+        result = Prepared();
+    }
+    cancelRequested = false;
+    ready = false;
+    thread = std::thread(&VideoPreloader::run, this, filePath, qMax(0, frameCount));
+}
+
+void VideoPreloader::cancel()
+{
+    cancelRequested = true;
+    join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    path.clear();
+    succeeded = false;
+    result = Prepared(); // Hazır frame'lerin slab'ları havuza döner
+    ready = false;
+}
+
+QString VideoPreloader::pendingPath() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return path;
+}
+
+bool VideoPreloader::take(const QString& filePath, Prepared& out)
+{
+    if (filePath.isEmpty() || pendingPath() != filePath) {
+        return false;
+    }
+    join(); // Genellikle çoktan bitmiştir
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path != filePath || !succeeded) {
+        return false;
+    }
+    out = std::move(result);
+    result = Prepared();
+    path.clear();
+    succeeded = false;
+    ready = false;
+    return true;
+}
+
+void VideoPreloader::join()
+{
+    std::lock_guard<std::mutex> lock(threadMutex);
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void VideoPreloader::run(QString filePath, int frameCount)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Prepared prepared;
+    prepared.capture = std::make_unique<cv::VideoCapture>();
+    if (!prepared.capture->open(filePath.toStdString()) || !prepared.capture->isOpened()) {
+        qDebug() << "VideoPreloader: Video açılamadı:" << filePath;
+        ready = true;
+        return;
+    }
+
+    // Metadata burada bir kez okunur, geçişte tekrar sorgulanmaz
+    cv::VideoCapture& capture = *prepared.capture;
+    VideoInfo& info = prepared.info;
+    info.filePath = filePath;
+    info.fileName = QFileInfo(filePath).fileName();
+    info.fileSize = static_cast<size_t>(QFileInfo(filePath).size());
+    info.width = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    info.height = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    info.fps = capture.get(cv::CAP_PROP_FPS);
+    info.totalFrames = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_COUNT));
+    info.duration = info.fps > 0 ? info.totalFrames / info.fps : 0.0;
+
+    // İlk frame'ler decode edilir: geçişte görüntüleme kuyruğu bunlarla hemen dolar
+    for (int i = 0; i < frameCount && !cancelRequested; ++i) {
+        cv::Mat frame = framePool ? framePool->acquire(info.height, info.width, CV_8UC3) : cv::Mat();
+        const uchar* pooledData = frame.data;
+        if (!capture.read(frame) || frame.empty()) {
+            break;
+        }
+        if (framePool && pooledData && frame.data != pooledData) {
+            framePool->reportReallocation();
+        }
+
+        FrameData frameData;
+        frameData.frameNumber = i;
+        frameData.timeStamp = capture.get(cv::CAP_PROP_POS_MSEC) / 1000.0;
+        if (frameData.timeStamp <= 0.0 && i > 0 && info.fps > 0) {
+            frameData.timeStamp = i / info.fps;
+        }
+        frameData.frame = frame;
+        info.currentTime = frameData.timeStamp;
+        prepared.frames.push_back(std::move(frameData));
+    }
+    info.currentFrameNumber = static_cast<int>(prepared.frames.size());
+
+    if (cancelRequested) {
+        return;
+    }
+
+    qDebug() << "VideoPreloader: Hazır:" << info.fileName << prepared.frames.size() << "frame,"
+             << timer.elapsed() << "ms";
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (path == filePath) {
+        result = std::move(prepared);
+        succeeded = true;
+    }
+    ready = true;
+}
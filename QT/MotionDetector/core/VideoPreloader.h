@@ -0,0 +1,62 @@
+#ifndef VIDEOPRELOADER_H
+#define VIDEOPRELOADER_H
+
+#include "core/FrameData.h"
+#include "core/FramePool.h"
+#include <QString>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/*
+ Playlist'teki sıradaki videoyu arka planda hazırlayan yardımcı
+ Oynatma sürerken ayrı bir thread'de dosya açılır, metadata bir kez okunur
+ ve ilk frameCount frame havuz buffer'larına decode edilir. VideoController
+ sıradaki videoya geçerken capture'ı ve hazır frame'leri devralır: açma,
+ probe ve ilk decode gecikmesi oynatmayı durdurmaz, görüntüleme kuyruğu boş kalmaz.
+ Aynı anda tek bir video hazırlanır, yeni start() öncekini iptal eder.
+ */
+class VideoPreloader {
+public:
+    struct Prepared {
+        std::unique_ptr<cv::VideoCapture> capture;  // Hazır frame'lerden sonraki konumda
+        VideoInfo info;                             // currentFrameNumber: capture konumu
+        std::deque<FrameData> frames;               // frameId atanmamış, dosya sırasıyla
+    };
+
+    explicit VideoPreloader(FramePool* framePool = nullptr);
+    ~VideoPreloader();
+
+    VideoPreloader(const VideoPreloader&) = delete;
+    VideoPreloader& operator=(const VideoPreloader&) = delete;
+
+    void start(const QString& filePath, int frameCount);
+    void cancel();
+
+    // Hazırlanan video (boşsa hiçbiri)
+    QString pendingPath() const;
+    bool isReady() const { return ready; }
+
+    // filePath hazırlanıyorsa bitmesi beklenir ve sonuç devredilir.
+    // Başka bir dosya hazırlanıyorsa ya da açılamadıysa false döner.
+    bool take(const QString& filePath, Prepared& out);
+
+private:
+    void run(QString filePath, int frameCount);
+    void join();
+
+    FramePool* framePool;
+    std::mutex threadMutex;     // thread'in başlatılması/beklenmesi
+    std::thread thread;
+    std::atomic<bool> cancelRequested;
+    std::atomic<bool> ready;
+
+    mutable std::mutex mutex;   // path ve result
+    QString path;
+    bool succeeded;
+    Prepared result;
+};
+
+#endif // VIDEOPRELOADER_H
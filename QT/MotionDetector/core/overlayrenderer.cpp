@@ -0,0 +1,168 @@
+#include "overlayrenderer.h"
+#include <QDebug>
+
+namespace {
+constexpr int LabelFont = cv::FONT_HERSHEY_SIMPLEX;
+constexpr double LabelFontScale = 0.7;
+constexpr int LabelThickness = 2;
+constexpr int LabelPadding = 8;
+}
+
+OverlayRenderer::OverlayRenderer(QObject *parent)
+    : QObject(parent),
+    jobs(1),
+    scheduled(false),
+    outputPool(8),
+    renderedCount(0),
+    skippedCount(0)
+{
+}
+
+void OverlayRenderer::submit(const FrameData& frameData, const DetectionResult& detections)
+{
+    bool needSchedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const int stream = qMax(0, frameData.streamId);
+        if (stream >= jobs.size()) {
+            jobs.resize(stream + 1);
+        }
+        Job& job = jobs[stream];
+        if (job.pending) {
+            skippedCount.fetch_add(1, std::memory_order_relaxed); // Önceki iş hiç çizilmeden yenisi geldi
+        }
+        job.frameData = frameData;
+        job.detections = detections;
+        job.pending = true;
+        needSchedule = !scheduled;
+        scheduled = true;
+    }
+
+    // Kuyrukta en fazla bir çağrı olur, art arda gelen işler birleşir
+    if (needSchedule) {
+        QMetaObject::invokeMethod(this, "processPending", Qt::QueuedConnection);
+    }
+}
+
+void OverlayRenderer::processPending()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scheduled = false;
+        drawing.resize(0);
+        for (Job& job : jobs) {
+            if (job.pending) {
+                drawing.append(std::move(job));
+                job = Job();
+            }
+        }
+    }
+
+    for (Job& job : drawing) {
+        FrameData& frameData = job.frameData;
+        if (frameData.frame.empty()) {
+            continue;
+        }
+
+        // Kaynak slab cache ve tespit kuyruğu ile paylaşıldığı için kopyaya çizilir
+        const cv::Mat& source = frameData.frame;
+        cv::Mat canvas = outputPool.acquire(source.rows, source.cols, source.type());
+        source.copyTo(canvas);
+        drawDetections(canvas, job.detections);
+
+        frameData.frame = canvas;
+        renderedCount.fetch_add(1, std::memory_order_relaxed);
+        emit frameRendered(frameData);
+    }
+    drawing.resize(0); // Frame referansları bırakılır
+}
+
+void OverlayRenderer::drawDetections(cv::Mat& frame, const DetectionResult& result)
+{
+    try {
+        const cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+
+        for (const Detection& detection : result.detections) {
+            if (!detection.isValid()) {
+                continue;
+            }
+
+            // Confidence e göre renk belirleme
+            cv::Scalar boxColor;
+            if (detection.confidence > 0.8) {
+                boxColor = cv::Scalar(0, 255, 0);      // Yüksek güven: Yeşil
+            } else if (detection.confidence > 0.5) {
+                boxColor = cv::Scalar(0, 255, 255);    // Orta güven: Sarı
+            } else {
+                boxColor = cv::Scalar(0, 165, 255);    // Düşük güven: Turuncu
+            }
+
+            // Kalınlık confidence'e göre
+            const int thickness = detection.confidence > 0.7 ? 3 : 2;
+            cv::rectangle(frame, detection.bbox, boxColor, thickness);
+
+            // Etiket kutunun hemen üstüne yerleşir
+            const LabelGlyph& glyph = labelGlyph(detection);
+            const cv::Point topLeft(detection.bbox.x, detection.bbox.y - glyph.size.height);
+            if ((cv::Rect(topLeft, glyph.size) & frameRect).area() > 0) {
+                drawLabel(frame, topLeft, glyph);
+            }
+        }
+
+    } catch (const cv::Exception& e) {
+        qDebug() << "OverlayRenderer: OpenCV exception:" << e.what();
+    }
+}
+
+const OverlayRenderer::LabelGlyph& OverlayRenderer::labelGlyph(const Detection& detection)
+{
+    const int percent = qBound(0, static_cast<int>(detection.confidence * 100), 100);
+    const qint64 key = (static_cast<qint64>(detection.trackId + 1) << 32) | (detection.classId * 101 + percent);
+
+    auto it = glyphCache.find(key);
+    if (it != glyphCache.end()) {
+        return *it;
+    }
+
+    // İz kimlikleri sürekli artar, bellek kontrolsüz büyümesin
+    if (glyphCache.size() >= 1024) {
+        glyphCache.clear();
+    }
+
+    // Metin ölçüsü ve rasterize edilmiş hali etiket başına sadece bir kez hesaplanır
+    QString label = QString("%1 %2%").arg(detection.className).arg(percent);
+    if (detection.trackId >= 0) {
+        label.prepend(QString("#%1 ").arg(detection.trackId));
+    }
+    const std::string text = label.toStdString();
+    int baseline = 0;
+    const cv::Size textSize = cv::getTextSize(text, LabelFont, LabelFontScale, LabelThickness, &baseline);
+
+    LabelGlyph glyph;
+    glyph.size = cv::Size(textSize.width + 2 * LabelPadding, textSize.height + 2 * LabelPadding);
+    glyph.textMask = cv::Mat::zeros(glyph.size, CV_8UC1);
+    cv::putText(glyph.textMask, text, cv::Point(LabelPadding, LabelPadding + textSize.height),
+                LabelFont, LabelFontScale, cv::Scalar(255), LabelThickness);
+
+    return *glyphCache.insert(key, glyph);
+}
+
+void OverlayRenderer::drawLabel(cv::Mat& frame, const cv::Point& topLeft, const LabelGlyph& glyph)
+{
+    // Frame dışına taşan kısım kırpılır, maske de aynı oranda kırpılır
+    const cv::Rect labelRect(topLeft, glyph.size);
+    const cv::Rect visible = labelRect & cv::Rect(0, 0, frame.cols, frame.rows);
+    cv::Mat roi = frame(visible);
+    const cv::Mat mask = glyph.textMask(cv::Rect(visible.tl() - labelRect.tl(), visible.size()));
+
+    // Yarı saydam siyah arka plan: sadece etiket bölgesi %30 karartılır
+    roi.convertTo(roi, -1, 0.7, 0.0);
+    roi.setTo(cv::Scalar(255, 255, 255), mask);
+}
+
+QString OverlayRenderer::getInfo() const
+{
+    return QString("OverlayRenderer[Rendered:%1, Skipped:%2]")
+        .arg(renderedCount.load(std::memory_order_relaxed))
+        .arg(skippedCount.load(std::memory_order_relaxed));
+}
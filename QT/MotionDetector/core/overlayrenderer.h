@@ -0,0 +1,69 @@
+#ifndef OVERLAYRENDERER_H
+#define OVERLAYRENDERER_H
+
+#include "ai/DetectionData.h"
+#include "core/FrameData.h"
+#include "core/FramePool.h"
+#include <QHash>
+#include <QObject>
+#include <QVector>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+/*
+ Tespit kutularını ve etiketlerini frame üzerine çizen işçi
+ Ana Thread submit() ile frame + tespitleri bırakır, çizim worker thread'inde
+ yapılır ve hazır frame frameRendered ile geri döner. Yetişilemezse sadece en
+ son gönderilen iş çizilir (aradakiler atlanır), böylece gecikme birikmez.
+ Çoklu izlemede her akışın (FrameData::streamId) kendi bekleyen işi vardır.
+ Etiket arka planı sadece etiket bölgesinde karartılır; metin boyutu ve metin
+ maskesi iz + sınıf + güven yüzdesi başına bir kez hesaplanıp saklanır.
+ */
+class OverlayRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OverlayRenderer(QObject *parent = nullptr);
+
+    // Her thread'den çağrılabilir. Kaynak frame değiştirilmez, çizim kopyaya yapılır.
+    void submit(const FrameData& frameData, const DetectionResult& detections);
+
+    QString getInfo() const;
+
+signals:
+    void frameRendered(const FrameData& frameData);
+
+private slots:
+    void processPending();
+
+private:
+    struct LabelGlyph {
+        cv::Size size;      // Arka plan dahil etiket boyutu
+        cv::Mat textMask;   // Metin pikselleri (CV_8UC1, 255 = metin)
+    };
+
+    void drawDetections(cv::Mat& frame, const DetectionResult& result);
+    const LabelGlyph& labelGlyph(const Detection& detection);
+    static void drawLabel(cv::Mat& frame, const cv::Point& topLeft, const LabelGlyph& glyph);
+
+    struct Job {
+        FrameData frameData;
+        DetectionResult detections;
+        bool pending = false;
+    };
+
+    // Akış başına bekleyen iş (en son gönderilen), indeks streamId
+    mutable std::mutex mutex;
+    QVector<Job> jobs;
+    QVector<Job> drawing;                     // Worker'ın aldığı işler (kapasite korunur)
+    bool scheduled;
+
+    FramePool outputPool;                     // Çizilen kopyalar için buffer'lar
+    QHash<qint64, LabelGlyph> glyphCache;     // Anahtar: trackId + classId * 101 + güven yüzdesi (sadece worker thread)
+    std::atomic<quint64> renderedCount;
+    std::atomic<quint64> skippedCount;
+};
+
+#endif // OVERLAYRENDERER_H
@@ -0,0 +1,421 @@
+#include "resultexporter.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QtEndian>
+
+namespace {
+
+constexpr int TextFlushBytes = 1024 * 1024;
+constexpr int FlushIntervalMs = 1000;
+constexpr quint32 BinaryVersion = 1;
+constexpr quint32 BinaryColumns = 15;
+
+// JSON string içinde özel karakterleri kaçışla. Kontrol karakterleri (sınıf adında
+// satır sonu, tab vb.) \u00XX olur, aksi halde JSON satırı bozulur
+void appendJsonString(QByteArray& out, const QString& value)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    out += '"';
+    for (const char c : value.toUtf8()) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if (byte < 0x20) {
+            out += "\\u00";
+            out += hexDigits[byte >> 4];
+            out += hexDigits[byte & 0xf];
+            continue;
+        }
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+// Virgül veya tırnak içeren CSV alanı tırnak içine alınır
+void appendCsvString(QByteArray& out, const QString& value)
+{
+    const QByteArray utf8 = value.toUtf8();
+    if (!utf8.contains(',') && !utf8.contains('"')) {
+        out += utf8;
+        return;
+    }
+    out += '"';
+    for (const char c : utf8) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+void writeLittleEndian(QFile& file, quint32 value)
+{
+    const quint32 le = qToLittleEndian(value);
+    file.write(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+template<typename T>
+void writeColumn(QFile& file, const QVector<T>& column)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    QVector<T> swapped(column.size());
+    qToLittleEndian<T>(column.constData(), column.size(), swapped.data());
+    file.write(reinterpret_cast<const char*>(swapped.constData()), swapped.size() * sizeof(T));
+#else
+    file.write(reinterpret_cast<const char*>(column.constData()), column.size() * sizeof(T));
+#endif
+}
+
+} // namespace
+
+ResultExporter::ResultExporter(QObject *parent)
+    : QObject(parent),
+    scheduled(false),
+    accepting(false),
+    flushTimer(nullptr),
+    recordCount(0),
+    rowCount(0),
+    bytesWritten(0),
+    droppedCount(0)
+{
+}
+
+ResultExporter::~ResultExporter()
+{
+    close();
+}
+
+void ResultExporter::submit(ExportRecord record)
+{
+    bool needSchedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!accepting) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pending.append(std::move(record));
+        needSchedule = !scheduled;
+        scheduled = true;
+    }
+
+    // Kuyrukta en fazla bir çağrı olur, bu arada gelen kayıtlar aynı turda yazılır
+    if (needSchedule) {
+        QMetaObject::invokeMethod(this, "processPending", Qt::QueuedConnection);
+    }
+}
+
+QString ResultExporter::basePathFor(const QString& path)
+{
+    for (const char* extension : {".csv", ".jsonl", ".mdres"}) {
+        if (path.endsWith(QLatin1String(extension), Qt::CaseInsensitive)) {
+            return path.left(path.size() - static_cast<int>(qstrlen(extension)));
+        }
+    }
+    return path;
+}
+
+int ResultExporter::parseFormats(const QString& list)
+{
+    int formats = 0;
+    for (const QString& part : list.split(',', Qt::SkipEmptyParts)) {
+        const QString name = part.trimmed().toLower();
+        if (name == "csv") {
+            formats |= Csv;
+        } else if (name == "jsonl" || name == "json") {
+            formats |= JsonLines;
+        } else if (name == "bin" || name == "mdres") {
+            formats |= Binary;
+        } else {
+            return 0;
+        }
+    }
+    return formats;
+}
+
+bool ResultExporter::open(const QString& basePath, int formats)
+{
+    close();
+
+    // Zamanlayıcı worker thread'inde oluşturulur ki timeout orada işlensin
+    if (!flushTimer) {
+        flushTimer = new QTimer(this);
+        connect(flushTimer, &QTimer::timeout, this, &ResultExporter::flush);
+    }
+
+    const struct {
+        int format;
+        QFile* file;
+        const char* extension;
+    } outputs[] = {
+        {Csv, &csvFile, ".csv"},
+        {JsonLines, &jsonFile, ".jsonl"},
+        {Binary, &binaryFile, ".mdres"},
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        files.clear();
+    }
+    QStringList opened;
+    for (const auto& output : outputs) {
+        output.file->setFileName(QString());
+    }
+    for (const auto& output : outputs) {
+        if (!(formats & output.format)) continue;
+        output.file->setFileName(basePath + output.extension);
+        if (!output.file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            const QString message = QString("Çıktı dosyası açılamadı: %1").arg(output.file->fileName());
+            qDebug() << "ResultExporter:" << message;
+            emit errorOccurred(message);
+            close();
+            return false;
+        }
+        opened.append(output.file->fileName());
+    }
+
+    if (csvFile.isOpen()) {
+        csvBuffer = "frame_id,frame_number,time,source_frame_id,track_id,class_id,class,"
+                    "confidence,x,y,width,height,speed,heading,moving,dwell_s\n";
+    }
+    if (binaryFile.isOpen()) {
+        binaryFile.write("MDRS", 4);
+        writeLittleEndian(binaryFile, BinaryVersion);
+        writeLittleEndian(binaryFile, BinaryColumns);
+    }
+
+    recordCount = 0;
+    rowCount = 0;
+    bytesWritten = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        accepting = true;
+        files = opened;
+    }
+    flushTimer->start(FlushIntervalMs);
+    qDebug() << "ResultExporter: Dışa aktarma başladı:" << opened;
+    return true;
+}
+
+void ResultExporter::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        accepting = false;
+    }
+    if (!csvFile.isOpen() && !jsonFile.isOpen() && !binaryFile.isOpen()) {
+        return;
+    }
+
+    processPending();
+    if (!columnFrameId.isEmpty()) {
+        writeBinaryBlock();
+    }
+    flush();
+    if (flushTimer) {
+        flushTimer->stop();
+    }
+
+    csvFile.close();
+    jsonFile.close();
+    binaryFile.close();
+
+    qDebug() << "ResultExporter: Dışa aktarma tamamlandı." << getInfo();
+    emit closed(recordCount.load(), rowCount.load());
+}
+
+void ResultExporter::processPending()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scheduled = false;
+        writing.swap(pending); // İki liste dönüşümlü kullanılır, kapasiteleri korunur
+    }
+
+    for (const ExportRecord& record : writing) {
+        if (csvFile.isOpen()) appendCsv(record);
+        if (jsonFile.isOpen()) appendJson(record);
+        if (binaryFile.isOpen()) appendBinary(record);
+        recordCount.fetch_add(1, std::memory_order_relaxed);
+        rowCount.fetch_add(record.result.detections.size(), std::memory_order_relaxed);
+    }
+    writing.clear();
+
+    // Küçük yazmalar yerine büyük ardışık eklemeler
+    if (csvBuffer.size() > TextFlushBytes) writeBuffer(csvFile, csvBuffer);
+    if (jsonBuffer.size() > TextFlushBytes) writeBuffer(jsonFile, jsonBuffer);
+}
+
+void ResultExporter::flush()
+{
+    writeBuffer(csvFile, csvBuffer);
+    writeBuffer(jsonFile, jsonBuffer);
+    for (QFile* file : {&csvFile, &jsonFile, &binaryFile}) {
+        if (file->isOpen()) file->flush();
+    }
+}
+
+void ResultExporter::writeBuffer(QFile& file, QByteArray& buffer)
+{
+    if (buffer.isEmpty() || !file.isOpen()) {
+        return;
+    }
+    const qint64 written = file.write(buffer);
+    if (written != buffer.size()) {
+        emit errorOccurred(QString("Yazma hatası: %1 (%2)").arg(file.fileName(), file.errorString()));
+    } else {
+        bytesWritten.fetch_add(written, std::memory_order_relaxed);
+    }
+    buffer.resize(0); // clear()'ın aksine kapasite korunur, sonraki turda yeniden ayrılmaz
+}
+
+void ResultExporter::appendCsv(const ExportRecord& record)
+{
+    const DetectionResult& result = record.result;
+    const QByteArray prefix = QByteArray::number(record.frameId) + ',' +
+                              QByteArray::number(record.frameNumber) + ',' +
+                              QByteArray::number(record.timeStamp, 'f', 3) + ',' +
+                              QByteArray::number(result.frameId) + ',';
+
+    for (int i = 0; i < result.detections.size(); ++i) {
+        const Detection& detection = result.detections[i];
+        csvBuffer += prefix;
+        csvBuffer += QByteArray::number(detection.trackId) + ',';
+        csvBuffer += QByteArray::number(detection.classId) + ',';
+        appendCsvString(csvBuffer, detection.className);
+        csvBuffer += ',' + QByteArray::number(detection.confidence, 'f', 3);
+        csvBuffer += ',' + QByteArray::number(detection.bbox.x) + ',' + QByteArray::number(detection.bbox.y);
+        csvBuffer += ',' + QByteArray::number(detection.bbox.width) + ',' + QByteArray::number(detection.bbox.height);
+        if (i < record.motion.size() && record.motion[i].trackId >= 0) {
+            const MotionAnalyzer::TrackMotion& motion = record.motion[i];
+            csvBuffer += ',' + QByteArray::number(motion.speed, 'f', 1);
+            csvBuffer += ',' + QByteArray::number(motion.heading, 'f', 1);
+            csvBuffer += motion.moving ? ",1," : ",0,";
+            csvBuffer += QByteArray::number(motion.dwellSeconds, 'f', 1);
+        } else {
+            csvBuffer += ",,,,";
+        }
+        csvBuffer += '\n';
+    }
+}
+
+void ResultExporter::appendJson(const ExportRecord& record)
+{
+    // {"frame_id":..,"frame_number":..,"time":..,"inference_ms":..,"detections":[..]}
+    const DetectionResult& result = record.result;
+    jsonBuffer += "{\"frame_id\":" + QByteArray::number(record.frameId);
+    jsonBuffer += ",\"frame_number\":" + QByteArray::number(record.frameNumber);
+    jsonBuffer += ",\"time\":" + QByteArray::number(record.timeStamp, 'f', 3);
+    if (result.frameId != record.frameId) {
+        jsonBuffer += ",\"source_frame_id\":" + QByteArray::number(result.frameId);
+    }
+    jsonBuffer += ",\"inference_ms\":" + QByteArray::number(result.processingTimeMs, 'f', 1);
+    jsonBuffer += ",\"detections\":[";
+    for (int i = 0; i < result.detections.size(); ++i) {
+        const Detection& detection = result.detections[i];
+        if (i > 0) jsonBuffer += ',';
+        jsonBuffer += "{\"class_id\":" + QByteArray::number(detection.classId);
+        jsonBuffer += ",\"class\":";
+        appendJsonString(jsonBuffer, detection.className);
+        jsonBuffer += ",\"confidence\":" + QByteArray::number(detection.confidence, 'f', 3);
+        jsonBuffer += ",\"bbox\":[" + QByteArray::number(detection.bbox.x) + ',' +
+                      QByteArray::number(detection.bbox.y) + ',' +
+                      QByteArray::number(detection.bbox.width) + ',' +
+                      QByteArray::number(detection.bbox.height) + ']';
+        if (detection.trackId >= 0) {
+            jsonBuffer += ",\"track_id\":" + QByteArray::number(detection.trackId);
+        }
+        if (i < record.motion.size() && record.motion[i].trackId >= 0) {
+            const MotionAnalyzer::TrackMotion& motion = record.motion[i];
+            jsonBuffer += ",\"speed\":" + QByteArray::number(motion.speed, 'f', 1);
+            jsonBuffer += ",\"heading\":" + QByteArray::number(motion.heading, 'f', 1);
+            jsonBuffer += motion.moving ? ",\"moving\":true" : ",\"moving\":false";
+            jsonBuffer += ",\"dwell\":" + QByteArray::number(motion.dwellSeconds, 'f', 1);
+        }
+        jsonBuffer += '}';
+    }
+    jsonBuffer += "]}\n";
+}
+
+void ResultExporter::appendBinary(const ExportRecord& record)
+{
+    const DetectionResult& result = record.result;
+    for (int i = 0; i < result.detections.size(); ++i) {
+        const Detection& detection = result.detections[i];
+        const bool hasMotion = i < record.motion.size() && record.motion[i].trackId >= 0;
+
+        columnFrameId.append(record.frameId);
+        columnFrameNumber.append(record.frameNumber);
+        columnTime.append(record.timeStamp);
+        columnSourceFrameId.append(result.frameId);
+        columnTrackId.append(detection.trackId);
+        columnClassId.append(detection.classId);
+        columnConfidence.append(static_cast<float>(detection.confidence));
+        columnX.append(detection.bbox.x);
+        columnY.append(detection.bbox.y);
+        columnWidth.append(detection.bbox.width);
+        columnHeight.append(detection.bbox.height);
+        columnSpeed.append(hasMotion ? static_cast<float>(record.motion[i].speed) : -1.0f);
+        columnHeading.append(hasMotion ? static_cast<float>(record.motion[i].heading) : 0.0f);
+        columnMoving.append(hasMotion && record.motion[i].moving ? 1 : 0);
+        columnDwell.append(hasMotion ? static_cast<float>(record.motion[i].dwellSeconds) : 0.0f);
+
+        if (columnFrameId.size() >= BinaryBlockRows) {
+            writeBinaryBlock();
+        }
+    }
+}
+
+void ResultExporter::writeBinaryBlock()
+{
+    const qint64 before = binaryFile.pos();
+    writeLittleEndian(binaryFile, static_cast<quint32>(columnFrameId.size()));
+    writeColumn(binaryFile, columnFrameId);
+    writeColumn(binaryFile, columnFrameNumber);
+    writeColumn(binaryFile, columnTime);
+    writeColumn(binaryFile, columnSourceFrameId);
+    writeColumn(binaryFile, columnTrackId);
+    writeColumn(binaryFile, columnClassId);
+    writeColumn(binaryFile, columnConfidence);
+    writeColumn(binaryFile, columnX);
+    writeColumn(binaryFile, columnY);
+    writeColumn(binaryFile, columnWidth);
+    writeColumn(binaryFile, columnHeight);
+    writeColumn(binaryFile, columnSpeed);
+    writeColumn(binaryFile, columnHeading);
+    writeColumn(binaryFile, columnMoving);
+    writeColumn(binaryFile, columnDwell);
+    bytesWritten.fetch_add(binaryFile.pos() - before, std::memory_order_relaxed);
+
+    // clear() kapasiteyi korur, sonraki blok için yeniden ayrılmaz
+    columnFrameId.clear();
+    columnFrameNumber.clear();
+    columnTime.clear();
+    columnSourceFrameId.clear();
+    columnTrackId.clear();
+    columnClassId.clear();
+    columnConfidence.clear();
+    columnX.clear();
+    columnY.clear();
+    columnWidth.clear();
+    columnHeight.clear();
+    columnSpeed.clear();
+    columnHeading.clear();
+    columnMoving.clear();
+    columnDwell.clear();
+}
+
+QStringList ResultExporter::outputFiles() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return files;
+}
+
+QString ResultExporter::getInfo() const
+{
+    return QString("ResultExporter[Records:%1, Rows:%2, Written:%3 MB, Dropped:%4]")
+        .arg(recordCount.load(std::memory_order_relaxed))
+        .arg(rowCount.load(std::memory_order_relaxed))
+        .arg(bytesWritten.load(std::memory_order_relaxed) / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(droppedCount.load(std::memory_order_relaxed));
+}
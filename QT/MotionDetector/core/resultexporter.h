@@ -0,0 +1,124 @@
+#ifndef RESULTEXPORTER_H
+#define RESULTEXPORTER_H
+
+#include "ai/DetectionData.h"
+#include "core/MotionAnalyzer.h"
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include <mutex>
+
+// Dışa aktarılan tek frame: tespitler ve (varsa) iz başına hareket bilgisi
+struct ExportRecord {
+    int frameId = -1;
+    int frameNumber = -1;
+    double timeStamp = 0.0;
+    DetectionResult result;                         // result.frameId: tespitin geldiği frame
+    QVector<MotionAnalyzer::TrackMotion> motion;    // Boş ya da result.detections ile aynı sırada
+};
+
+/*
+ Tespit sonuçlarını kendi thread'inde diske yazan işçi
+ submit() her thread'den çağrılabilir, kayıtlar kilitli bir listeye eklenip
+ worker thread'de biçimlendirilir; çağıran taraf disk beklemez ve kayıt düşmez.
+ Biçimler:
+   .csv    tespit başına bir satır
+   .jsonl  frame başına bir JSON satırı
+   .mdres  sütunlu ikili biçim: "MDRS" + sürüm, ardından blok başına satır sayısı
+           ve her sütun little-endian ardışık dizi olarak (sınıf adı yok, classId var)
+ Metin tamponları 1 MB'ı geçince, ikili blok BinaryBlockRows satıra ulaşınca
+ yazılır; dosyalar saniyede bir flush edilir.
+ */
+class ResultExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format {
+        Csv = 0x1,
+        JsonLines = 0x2,
+        Binary = 0x4
+    };
+
+    static constexpr int BinaryBlockRows = 16384;
+
+    explicit ResultExporter(QObject *parent = nullptr);
+    ~ResultExporter();
+
+    // Her thread'den çağrılabilir. Açık dosya yoksa kayıt atılır.
+    void submit(ExportRecord record);
+
+    // "sonuc.jsonl" gibi bilinen bir uzantı verilirse uzantısız hali taban alınır
+    static QString basePathFor(const QString& path);
+    // Virgülle ayrılmış biçim listesi ("csv,jsonl,bin") -> Format bayrakları, hatalıysa 0
+    static int parseFormats(const QString& list);
+
+    // Her thread'den çağrılabilir, kapandıktan sonra da son açılan dosyaları döner
+    QStringList outputFiles() const;
+    QString getInfo() const;
+
+public slots:
+    // basePath + biçim uzantısı dosyalarını oluşturur. Açık dosyalar önce kapatılır.
+    bool open(const QString& basePath, int formats);
+    // Bekleyen kayıtları yazar ve dosyaları kapatır
+    void close();
+
+signals:
+    void errorOccurred(const QString& errorMessage);
+    void closed(quint64 records, quint64 rows);
+
+private slots:
+    void processPending();
+    void flush();
+
+private:
+    void appendCsv(const ExportRecord& record);
+    void appendJson(const ExportRecord& record);
+    void appendBinary(const ExportRecord& record);
+    void writeBinaryBlock();
+    void writeBuffer(QFile& file, QByteArray& buffer);
+
+    // Bekleyen kayıtlar (her thread'den doldurulur)
+    mutable std::mutex mutex;
+    QVector<ExportRecord> pending;
+    bool scheduled;
+    bool accepting;
+    QStringList files;              // Son open()'da açılan dosyalar (outputFiles için)
+
+    // Aşağıdakiler sadece worker thread'de kullanılır
+    QVector<ExportRecord> writing;
+    QFile csvFile;
+    QFile jsonFile;
+    QFile binaryFile;
+    QByteArray csvBuffer;
+    QByteArray jsonBuffer;
+    QTimer* flushTimer;
+
+    // İkili blok sütunları (blok boyunca biriktirilir, yeniden ayrılmaz)
+    QVector<qint32> columnFrameId;
+    QVector<qint32> columnFrameNumber;
+    QVector<double> columnTime;
+    QVector<qint32> columnSourceFrameId;
+    QVector<qint32> columnTrackId;
+    QVector<qint32> columnClassId;
+    QVector<float> columnConfidence;
+    QVector<qint32> columnX;
+    QVector<qint32> columnY;
+    QVector<qint32> columnWidth;
+    QVector<qint32> columnHeight;
+    QVector<float> columnSpeed;
+    QVector<float> columnHeading;
+    QVector<quint8> columnMoving;
+    QVector<float> columnDwell;
+
+    std::atomic<quint64> recordCount;
+    std::atomic<quint64> rowCount;
+    std::atomic<quint64> bytesWritten;
+    std::atomic<quint64> droppedCount;
+};
+
+#endif // RESULTEXPORTER_H
@@ -1,21 +1,46 @@
 #include "videocontroller.h"
+#include "core/SegmentDecoder.h"
 #include <QFileInfo>
 #include <QDebug>
 #include <qthread.h>
 
-VideoController::VideoController(FrameQueue* displayQueue, QObject *parent)
+VideoController::VideoController(FrameQueue* displayQueue, FramePool* framePool, QObject *parent)
     : QObject(parent),
+    videoCapture(std::make_unique<cv::VideoCapture>()),
     displayQueue(displayQueue),
+    detectionQueue(nullptr),
+    detectionScheduler(nullptr),
+    detectionEnabled(false),
+    streamId(0),
+    framePool(framePool),
+    preloader(framePool),
+    autoAdvance(false),
+    switchRequested(false),
     nextFrameId(0),
-    isRunning(false)
+    isRunning(false),
+    offlineMode(false),
+    decodeWorkers(0),
+    playbackRate(1.0),
+    decodesSkipped(0),
+    maxQueuedFrames(8),
+    indexCancel(false),
+    pendingSeekFrame(-1),
+    videoFps(0.0),
+    prefetchFrames(15),
+    playhead(-1)
 {
     qDebug() << "VideoController: Worker oluşturuldu.";
+    // Havuzun yarısı kuyruklar, overlay ve tespit için serbest kalır
+    if (framePool) {
+        frameCache.setMaxFrames(framePool->capacity() / 2);
+    }
     resetVideoInfo();
 }
 
 VideoController::~VideoController()
 {
     closeVideo();
+    stopIndexBuild();
     qDebug() << "VideoController: Worker silindi.";
 }
 
@@ -26,9 +51,13 @@ bool VideoController::openVideo(const QString& filePath) {
 void VideoController::closeVideo()
 {
     stopProcessing();
-    if (videoCapture.isOpened()) {
-        videoCapture.release();
+    stopIndexBuild();
+    // Decode döngüsü capture'ı bırakana kadar beklenir
+    std::lock_guard<std::mutex> captureLock(captureMutex);
+    if (videoCapture->isOpened()) {
+        videoCapture->release();
     }
+    primedFrames.clear();
     resetVideoInfo();
 }
 
@@ -38,33 +67,482 @@ void VideoController::stopProcessing()
 }
 
 void VideoController::startProcessing() {
-    if (!videoCapture.isOpened() || isRunning) {
+    std::lock_guard<std::mutex> captureLock(captureMutex);
+    if (!videoCapture->isOpened() || isRunning) {
         return;
     }
 
     isRunning = true;
+    if (applyPendingSeek() < 0 && playhead >= 0 &&
+        currentVideoInfo.currentFrameNumber != playhead + 1) {
+        // Duraklatılmışken cache'ten gösterilen frame'e göre capture konumu geride kaldı
+        seekCapture(playhead + 1);
+    }
+
+    // Offline modda segment paralel decode denenir, olmazsa sıralı decode'a dönülür.
+    // Segmentler capture konumundan başlar, hazırlıktan devralınan frame'ler önce gönderilir.
+    if (offlineMode) {
+        FrameData primed;
+        while (isRunning && takePrimedFrame(primed)) {
+            deliverFrame(std::move(primed));
+        }
+    }
+    if (offlineMode && processSegmented()) {
+        isRunning = false;
+        return;
+    }
 
-    while (isRunning && videoCapture.isOpened()) {
-        cv::Mat frame;
-        if (!videoCapture.read(frame) || frame.empty()) {
+    while (isRunning && videoCapture->isOpened()) {
+        // Oynatma sırasında gelen seek bir sonraki frame'den önce uygulanır
+        if (pendingSeekFrame.load() >= 0) {
+            applyPendingSeek();
+        }
+        if (switchRequested.exchange(false)) {
+            switchToPreloaded();
+        }
+
+        FrameData frameData;
+        if (!takePrimedFrame(frameData) && !decodeNext(frameData)) {
+            // Video bitti: sıradaki hazırlandıysa duraksamadan ona geçilir
+            if (autoAdvance && !offlineMode && switchToPreloaded()) {
+                continue;
+            }
             emit videoFinished();
             break;
         }
 
+        deliverFrame(std::move(frameData));
+        skipForPlaybackRate();
+
+        emit progressChanged(currentVideoInfo.getProgress());
+    }
+
+    isRunning = false;
+}
+
+bool VideoController::processSegmented()
+{
+    SegmentDecoder decoder(currentVideoInfo.filePath, framePool, decodeWorkers);
+    decoder.setFrameIndex(waitForIndex()); // Tarama zaten sürüyorsa ikinci kez yapılmaz
+    if (!decoder.start(currentVideoInfo.totalFrames, currentVideoInfo.currentFrameNumber)) {
+        qDebug() << "VideoController: Segment decode başlatılamadı, sıralı decode kullanılacak.";
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    FrameData frameData;
+    int delivered = 0;
+    while (isRunning && decoder.next(frameData, isRunning)) {
+        currentVideoInfo.currentFrameNumber = frameData.frameNumber + 1;
+        currentVideoInfo.currentTime = frameData.timeStamp;
+        frameData.frameId = nextFrameId++;
+        deliverFrame(std::move(frameData));
+
+        // Yüksek hızda her frame için sinyal göndermek UI kuyruğunu doldurur
+        if (++delivered % 30 == 0) {
+            emit progressChanged(currentVideoInfo.getProgress());
+        }
+    }
+
+    const bool finished = isRunning;
+    const double seconds = timer.elapsed() / 1000.0;
+    qDebug() << "VideoController: Segment decode" << (finished ? "tamamlandı," : "durduruldu,")
+             << delivered << "frame," << (seconds > 0 ? delivered / seconds : 0.0) << "FPS,"
+             << decoder.getInfo();
+    decoder.stop();
+
+    if (finished) {
+        emit progressChanged(1.0);
+        emit videoFinished();
+    }
+    return true;
+}
+
+bool VideoController::decodeNext(FrameData& frameData, bool cache)
+{
+    // Decode doğrudan havuzdan gelen buffer'a yapılır
+    cv::Mat frame = acquireFrameBuffer();
+    const uchar* pooledData = frame.data;
+    if (!videoCapture->read(frame) || frame.empty()) {
+        return false;
+    }
+    if (framePool && pooledData && frame.data != pooledData) {
+        framePool->reportReallocation();
+    }
+
+    updateVideoInfo();
+    frameData = createFrameData(frame);
+
+    // Sadece seek/adım hedefleri ve çevreleri saklanır. Oynatmadaki her frame
+    // saklansaydı havuzun tüm slab'ları cache'te kalır, decode havuz dışına düşerdi.
+    if (cache && !offlineMode) {
+        frameCache.insert(frameData);
+    }
+    return true;
+}
+
+void VideoController::skipForPlaybackRate()
+{
+    // 4x hızda ekran her dört frame'den birini gösterebilir, diğerleri decode
+    // edilip kuyrukta düşürülürdü. Bunlar grab() ile geçilir: paket çözülür ama
+    // retrieve (BGR dönüşümü ve kopya) yapılmaz, tespite de gönderilmez.
+    const int skip = static_cast<int>(playbackRate.load()) - 1;
+    if (skip <= 0 || offlineMode || !primedFrames.empty()) {
+        return;
+    }
+
+    int skipped = 0;
+    while (skipped < skip && isRunning && pendingSeekFrame.load() < 0 && videoCapture->grab()) {
+        ++skipped;
+    }
+    if (skipped > 0) {
+        decodesSkipped += skipped;
+        updateVideoInfo(); // seekCapture capture konumunu buradan okur
+    }
+}
+
+bool VideoController::takePrimedFrame(FrameData& frameData)
+{
+    if (primedFrames.empty()) {
+        return false;
+    }
+    frameData = std::move(primedFrames.front());
+    primedFrames.pop_front();
+    frameData.frameId = nextFrameId++;
+    return true;
+}
+
+void VideoController::deliverFrame(FrameData&& frameData)
+{
+    if (!displayQueue) {
+        return;
+    }
+    playhead = frameData.frameNumber;
+    frameData.streamId = streamId;
+
+    // Offline analiz tam bir geçiştir: zamanlayıcı atlanır, her frame tespite gider
+    // ve kuyruk doluyken en eskisi düşürülmek yerine backend yetişene kadar beklenir
+    if (detectionQueue && detectionEnabled &&
+        (offlineMode || !detectionScheduler ||
+         detectionScheduler->shouldForward(frameData.frameId, static_cast<int>(detectionQueue->size())))) {
+        if (!motionGate.check(frameData.frame)) {
+            emit detectionSkipped(frameData.frameId);
+        } else if (offlineMode) {
+            FrameData request(frameData); // Header kopyası, piksel verisi paylaşılır
+            while (isRunning && detectionEnabled && !detectionQueue->try_push(std::move(request))) {
+                QThread::msleep(1);
+            }
+        } else {
+            detectionQueue->push(FrameData(frameData));
+        }
+    }
+
+    if (offlineMode) {
+        // Offline analizde frame düşürülmez, tüketici yetişene kadar beklenir
+        while (isRunning && !displayQueue->try_push(std::move(frameData))) {
+            QThread::msleep(1);
+        }
+        return;
+    }
+
+    // Oynatmada zamanlamayı ekrandaki PresentationClock yapar. Decode sabit bir
+    // uyku yerine kuyruktaki frame sayısı ile sınırlanır: en fazla maxQueuedFrames
+    // kadar önde gidilir, böylece gecikme ve bellek kullanımı sınırlı kalır.
+    while (isRunning && displayQueue->size() >= static_cast<size_t>(maxQueuedFrames)) {
+        QThread::msleep(2);
+    }
+    displayQueue->push(std::move(frameData));
+}
+
+void VideoController::setOfflineMode(bool enabled)
+{
+    offlineMode = enabled;
+}
+
+void VideoController::setPlaybackRate(double rate)
+{
+    playbackRate = qMax(0.0, rate);
+}
+
+void VideoController::setDecodeWorkers(int count)
+{
+    decodeWorkers = qMax(0, count);
+}
+
+void VideoController::seekToFrame(int frameNumber)
+{
+    pendingSeekFrame = qMax(0, frameNumber);
+    if (!isRunning) {
+        // Döngü çalışmıyorsa istek worker thread'inde hemen işlenir
+        QMetaObject::invokeMethod(this, "processPendingSeek", Qt::QueuedConnection);
+    }
+}
+
+void VideoController::stepFrames(int delta)
+{
+    // Önceki adım henüz işlenmediyse onun hedefinden devam edilir
+    const int pending = pendingSeekFrame.load();
+    seekToFrame((pending >= 0 ? pending : playhead.load()) + delta);
+}
+
+void VideoController::setFrameCacheBudget(qint64 bytes)
+{
+    frameCache.setBudget(bytes);
+}
+
+void VideoController::setPrefetchFrames(int count)
+{
+    prefetchFrames = qMax(0, count);
+}
+
+void VideoController::preloadVideo(const QString& filePath)
+{
+    constexpr int PreloadFrames = 12; // Görüntüleme kuyruğunu (maxQueuedFrames) doldurmaya yeter
+    if (filePath.isEmpty()) {
+        preloader.cancel();
+        return;
+    }
+    if (preloader.pendingPath() != filePath) {
+        preloader.start(filePath, PreloadFrames);
+    }
+}
+
+bool VideoController::requestSwitchToPreloaded()
+{
+    if (!isRunning || preloader.pendingPath().isEmpty()) {
+        return false;
+    }
+    switchRequested = true;
+    return true;
+}
+
+bool VideoController::switchToPreloaded()
+{
+    const QString filePath = preloader.pendingPath();
+    if (filePath.isEmpty() || !adoptPreloaded(filePath)) {
+        return false;
+    }
+    // Kuyruktaki eski video frame'leri oynatılmaya devam eder, yeni video arkalarından gelir
+    qDebug() << "VideoController: Sıradaki videoya geçildi:" << currentVideoInfo.fileName;
+    emit videoSwitched(currentVideoInfo, nextFrameId);
+    return true;
+}
+
+bool VideoController::adoptPreloaded(const QString& filePath)
+{
+    VideoPreloader::Prepared prepared;
+    if (!preloader.take(filePath, prepared)) {
+        return false;
+    }
+
+    stopIndexBuild();
+    // Eski capture prepared ile birlikte kapanır
+    std::swap(videoCapture, prepared.capture);
+    currentVideoInfo = prepared.info;
+    primedFrames = std::move(prepared.frames);
+
+    videoFps = currentVideoInfo.fps;
+    pendingSeekFrame = -1;
+    playhead = -1;
+    frameCache.clear();
+    motionGate.reset();
+    startIndexBuild(filePath);
+    return true;
+}
+
+void VideoController::seekToTime(double seconds)
+{
+    const std::shared_ptr<const FrameIndex> currentIndex = frameIndex();
+    if (currentIndex && currentIndex->isValid()) {
+        seekToFrame(currentIndex->frameForTime(seconds));
+    } else {
+        seekToFrame(static_cast<int>(seconds * videoFps.load()));
+    }
+}
+
+std::shared_ptr<const FrameIndex> VideoController::frameIndex() const
+{
+    std::lock_guard<std::mutex> lock(indexMutex);
+    return index;
+}
+
+void VideoController::processPendingSeek()
+{
+    if (isRunning) {
+        return; // Decode döngüsü isteği kendisi uygular
+    }
+    std::lock_guard<std::mutex> captureLock(captureMutex);
+    int target = pendingSeekFrame.exchange(-1);
+    if (target < 0 || !videoCapture->isOpened()) {
+        return;
+    }
+    if (currentVideoInfo.totalFrames > 0) {
+        target = qMin(target, currentVideoInfo.totalFrames - 1);
+    }
+    const int direction = (playhead >= 0 && target < playhead) ? -1 : 1;
+
+    // Geri adım ve küçük scrub'lar cache'ten karşılanır. Kaçırılırsa keyframe'den
+    // hedefe kadar decode edilir, hedefin hemen öncesindeki frame'ler de cache'e girer.
+    FrameData frameData;
+    if (frameCache.get(target, frameData)) {
+        frameData.frameId = nextFrameId++; // Tespit eşleşmesi için her gösterim yeni kimlik alır
+    } else if (!seekCapture(target, true) || !decodeNext(frameData, true)) {
+        qDebug() << "VideoController: Seek başarısız, frame:" << target;
+        return;
+    }
+
+    if (displayQueue) {
+        displayQueue->clear();
+    }
+    deliverFrame(std::move(frameData));
+    emit seekFinished(target);
+    if (currentVideoInfo.totalFrames > 0) {
+        emit progressChanged(static_cast<double>(target + 1) / currentVideoInfo.totalFrames);
+    }
+
+    prefetchAround(target, direction);
+}
+
+void VideoController::prefetchAround(int frameNumber, int direction)
+{
+    const int count = prefetchFrames;
+    if (count <= 0) {
+        return;
+    }
+
+    int first = direction < 0 ? frameNumber - count : frameNumber + 1;
+    int last = direction < 0 ? frameNumber - 1 : frameNumber + count;
+    first = qMax(0, first);
+    if (currentVideoInfo.totalFrames > 0) {
+        last = qMin(last, currentVideoInfo.totalFrames - 1);
+    }
+
+    // Zaten cache'te olan uçlar tekrar decode edilmez
+    while (first <= last && frameCache.contains(first)) ++first;
+    while (last >= first && frameCache.contains(last)) --last;
+    if (first > last || !seekCapture(first, true)) {
+        return;
+    }
+
+    FrameData frameData;
+    for (int n = first; n <= last; ++n) {
+        // Yeni bir istek geldiyse (scrub sürüyor ya da oynatma başladı) prefetch bırakılır
+        if (isRunning || pendingSeekFrame.load() >= 0 || !decodeNext(frameData, true)) {
+            break;
+        }
+    }
+}
+
+int VideoController::applyPendingSeek()
+{
+    const int target = pendingSeekFrame.exchange(-1);
+    if (target < 0 || !videoCapture->isOpened()) {
+        return -1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    if (!seekCapture(target)) {
+        qDebug() << "VideoController: Seek başarısız, frame:" << target;
+        return -1;
+    }
+    // Seek öncesi decode edilmiş frame'ler artık geçersiz. Tek üretici bu thread
+    // olduğu için temizlikten sonra kuyruğa sadece hedef ve sonrası girer.
+    if (displayQueue) {
+        displayQueue->clear();
+    }
+    playhead = target - 1;
+    qDebug() << "VideoController: Frame" << target << "seek" << timer.elapsed() << "ms";
+
+    emit seekFinished(target);
+    return target;
+}
+
+bool VideoController::seekCapture(int targetFrame, bool cacheSkipped)
+{
+    if (currentVideoInfo.totalFrames > 0) {
+        targetFrame = qMin(targetFrame, currentVideoInfo.totalFrames - 1);
+    }
+    primedFrames.clear(); // Capture konumu değişiyor, hazır frame'ler artık sırada değil
+
+    const std::shared_ptr<const FrameIndex> currentIndex = frameIndex();
+    const int keyframe = currentIndex ? currentIndex->keyframeBefore(targetFrame) : -1;
+    if (keyframe < 0) {
+        // Index henüz hazır değil, OpenCV'nin kendi (yavaş) seek'i kullanılır
+        if (!videoCapture->set(cv::CAP_PROP_POS_FRAMES, targetFrame)) {
+            return false;
+        }
         updateVideoInfo();
-        FrameData frameData = createFrameData(frame);
+        return true;
+    }
 
-        if (displayQueue) {
-            displayQueue->push(frameData);
+    // Hedef aynı GOP içinde ilerideyse keyframe'e dönmeye gerek yok
+    int position = currentVideoInfo.currentFrameNumber;
+    if (position < keyframe || position > targetFrame) {
+        if (!videoCapture->set(cv::CAP_PROP_POS_FRAMES, keyframe)) {
+            return false;
         }
+        position = keyframe;
+    }
 
-        emit progressChanged(currentVideoInfo.getProgress());
+    // grab() frame'i decode eder ama BGR'ye dönüştürmez, ara frame'ler için yeterli.
+    // cacheSkipped ise hedefe yakın olanlar dönüştürülüp geri adımlar için cache'e konur.
+    FrameData skipped;
+    while (position < targetFrame) {
+        const bool keep = cacheSkipped && targetFrame - position <= prefetchFrames;
+        if (keep ? !decodeNext(skipped, true) : !videoCapture->grab()) {
+            break;
+        }
+        ++position;
+    }
+
+    currentVideoInfo.currentFrameNumber = position;
+    currentVideoInfo.currentTime = currentIndex->timeForFrame(position);
+    return position == targetFrame;
+}
 
-        // Performans kontrolü
-        QThread::msleep(33); //
+void VideoController::startIndexBuild(const QString& filePath)
+{
+    stopIndexBuild();
+
+    std::lock_guard<std::mutex> lock(indexThreadMutex);
+    indexCancel = false;
+    indexThread = std::thread([this, filePath]() {
+        auto built = std::make_shared<const FrameIndex>(FrameIndex::loadOrBuild(filePath, &indexCancel));
+        if (indexCancel || !built->isValid()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> indexLock(indexMutex);
+            index = built;
+        }
+        emit indexReady(built->keyframeCount());
+    });
+}
+
+void VideoController::stopIndexBuild()
+{
+    indexCancel = true; // Kilidi tutan waitForIndex() de hemen dönsün
+    std::lock_guard<std::mutex> lock(indexThreadMutex);
+    if (indexThread.joinable()) {
+        indexThread.join();
     }
 
-    isRunning = false;
+    std::lock_guard<std::mutex> indexLock(indexMutex);
+    index.reset();
+}
+
+std::shared_ptr<const FrameIndex> VideoController::waitForIndex()
+{
+    {
+        std::lock_guard<std::mutex> lock(indexThreadMutex);
+        if (indexThread.joinable()) {
+            indexThread.join();
+        }
+    }
+    return frameIndex();
 }
 
 
@@ -74,24 +552,33 @@ FrameData VideoController::createFrameData(const cv::Mat& frame)
 {
     FrameData frameData;
     frameData.frameId = nextFrameId++;
+    // POS_FRAMES okunduktan sonra sıradaki frame'i gösterir, frameNumber 0 tabanlıdır
+    frameData.frameNumber = currentVideoInfo.currentFrameNumber - 1;
     frameData.timeStamp = currentVideoInfo.currentTime;
-    frameData.frameNumber = currentVideoInfo.currentFrameNumber;
-    frameData.frame = frame.clone(); // Veri bütünlüğü için klonla
+    if (frameData.timeStamp <= 0.0 && frameData.frameNumber > 0 && currentVideoInfo.fps > 0) {
+        // Bazı container'lar POS_MSEC vermez, zaman frame numarasından hesaplanır
+        frameData.timeStamp = frameData.frameNumber / currentVideoInfo.fps;
+    }
+    // Buffer havuzdan geldiği için clone gerekmez, her frame kendi slab'ını kullanır.
+    // Slab, son FrameData kopyası silindiğinde havuza geri döner.
+    frameData.frame = frame;
     return frameData;
 }
 
-bool VideoController::updateVideoInfo()
+cv::Mat VideoController::acquireFrameBuffer()
 {
-    if (!videoCapture.isOpened()) return false;
-    currentVideoInfo.totalFrames = static_cast<int>(videoCapture.get(cv::CAP_PROP_FRAME_COUNT));
-    currentVideoInfo.fps = videoCapture.get(cv::CAP_PROP_FPS);
-    currentVideoInfo.width = static_cast<int>(videoCapture.get(cv::CAP_PROP_FRAME_WIDTH));
-    currentVideoInfo.height = static_cast<int>(videoCapture.get(cv::CAP_PROP_FRAME_HEIGHT));
-    currentVideoInfo.currentFrameNumber = static_cast<int>(videoCapture.get(cv::CAP_PROP_POS_FRAMES));
-    currentVideoInfo.currentTime = videoCapture.get(cv::CAP_PROP_POS_MSEC) / 1000.0;
-    if (currentVideoInfo.fps > 0) {
-        currentVideoInfo.duration = currentVideoInfo.totalFrames / currentVideoInfo.fps;
+    if (!framePool) {
+        return cv::Mat();
     }
+    return framePool->acquire(currentVideoInfo.height, currentVideoInfo.width, CV_8UC3);
+}
+
+bool VideoController::updateVideoInfo()
+{
+    if (!videoCapture->isOpened()) return false;
+    // Boyut, fps ve süre açılışta bir kez okunur, her frame'de sadece konum sorgulanır
+    currentVideoInfo.currentFrameNumber = static_cast<int>(videoCapture->get(cv::CAP_PROP_POS_FRAMES));
+    currentVideoInfo.currentTime = videoCapture->get(cv::CAP_PROP_POS_MSEC) / 1000.0;
     return true;
 }
 
@@ -99,27 +586,49 @@ void VideoController::resetVideoInfo()
 {
     currentVideoInfo = VideoInfo();
     nextFrameId = 0;
+    playhead = -1;
+    frameCache.clear(); // Slab'lar havuza döner
 }
 bool VideoController::openVideoDirectly(const QString& filePath) {
-    // Mevcut video'yu kapat
-    if (videoCapture.isOpened()) {
-        videoCapture.release();
+    // Mevcut video'yu kapat. Ana thread'den çağrıldığında decode döngüsü
+    // durdurulur ve capture ile hazır frame'ler değiştirilmeden önce bitmesi beklenir.
+    stopProcessing();
+    stopIndexBuild();
+    std::lock_guard<std::mutex> captureLock(captureMutex);
+    primedFrames.clear();
+
+    // Arka planda hazırlandıysa açma ve ilk decode beklenmez
+    if (adoptPreloaded(filePath)) {
+        nextFrameId = 0;
+        emit videoOpened(currentVideoInfo);
+        return true;
+    }
+    preloader.cancel();
+
+    if (videoCapture->isOpened()) {
+        videoCapture->release();
     }
 
     // Basit açma
-    bool success = videoCapture.open(filePath.toStdString());
+    bool success = videoCapture->open(filePath.toStdString());
 
-    if (success && videoCapture.isOpened()) {
+    if (success && videoCapture->isOpened()) {
         // Video bilgilerini güncelle
         currentVideoInfo.filePath = filePath;
         currentVideoInfo.fileName = QFileInfo(filePath).fileName();
-        currentVideoInfo.width = static_cast<int>(videoCapture.get(cv::CAP_PROP_FRAME_WIDTH));
-        currentVideoInfo.height = static_cast<int>(videoCapture.get(cv::CAP_PROP_FRAME_HEIGHT));
-        currentVideoInfo.fps = videoCapture.get(cv::CAP_PROP_FPS);
-        currentVideoInfo.totalFrames = static_cast<int>(videoCapture.get(cv::CAP_PROP_FRAME_COUNT));
+        currentVideoInfo.width = static_cast<int>(videoCapture->get(cv::CAP_PROP_FRAME_WIDTH));
+        currentVideoInfo.height = static_cast<int>(videoCapture->get(cv::CAP_PROP_FRAME_HEIGHT));
+        currentVideoInfo.fps = videoCapture->get(cv::CAP_PROP_FPS);
+        currentVideoInfo.totalFrames = static_cast<int>(videoCapture->get(cv::CAP_PROP_FRAME_COUNT));
         currentVideoInfo.duration = currentVideoInfo.totalFrames / currentVideoInfo.fps;
 
         nextFrameId = 0;
+        videoFps = currentVideoInfo.fps;
+        pendingSeekFrame = -1;
+        playhead = -1;
+        frameCache.clear();
+        motionGate.reset();
+        startIndexBuild(filePath);
 
         // Signal emit et
         emit videoOpened(currentVideoInfo);
@@ -1,27 +1,93 @@
 #ifndef VIDEOCONTROLLER_H
 #define VIDEOCONTROLLER_H
 
+#include "core/DetectionScheduler.h"
+#include "core/FrameCache.h"
 #include "core/FrameData.h"
+#include "core/FrameIndex.h"
+#include "core/MotionGate.h"
 #include "core/ThreadQueue.h"
+#include "core/FramePool.h"
+#include "core/VideoPreloader.h"
 #include <QObject>
 #include <QTimer>
 #include <QElapsedTimer>
 #include <opencv2/opencv.hpp>
 #include <atomic> // Döngüyü güvenli bir şekilde durdurmak için
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 class VideoController : public QObject
 {
     Q_OBJECT
 
 public:
-    // Kurucu fonksiyon artık kuyrukları parametre olarak alıyor
-    explicit VideoController(FrameQueue* displayQueue, QObject *parent = nullptr);
+    // Kurucu fonksiyon artık kuyrukları ve frame havuzunu parametre olarak alıyor
+    explicit VideoController(FrameQueue* displayQueue, FramePool* framePool = nullptr, QObject *parent = nullptr);
     ~VideoController();
 
     // Bu metodlar hala Ana Thread den çağrılabilir
     bool openVideo(const QString &filePath);
     void closeVideo();
     bool openVideoDirectly(const QString& filePath); ////////////
+
+    // Offline analiz modu: video segmentlere bölünüp paralel decode edilir,
+    // 33 ms bekleme yapılmaz ve tüketici yetişmezse frame düşürmek yerine beklenir.
+    // startProcessing öncesinde ayarlanmalıdır.
+    void setOfflineMode(bool enabled);
+    bool isOfflineMode() const { return offlineMode; }
+    void setDecodeWorkers(int count); // 0: çekirdek sayısına göre
+
+    // Seek istekleri her thread'den yapılabilir. Oynatma sürerken decode döngüsü
+    // isteği bir sonraki frame'den önce uygular, duraklatılmışken hedef frame
+    // hemen decode edilip görüntüleme kuyruğuna konur. Art arda gelen istekler
+    // (slider sürükleme) birleştirilir, sadece en sonuncusu uygulanır.
+    void seekToFrame(int frameNumber);
+    void seekToTime(double seconds);
+    // Tespit istekleri decode anında kuyruğa konur, böylece sonuçlar çoğunlukla
+    // frame ekrana gelmeden döner. Hangi frame'in gideceğine scheduler karar verir
+    // (verilmemişse ya da offline modda her frame gider).
+    void setDetectionQueue(FrameQueue* queue) { detectionQueue = queue; }
+    void setDetectionScheduler(DetectionScheduler* scheduler) { detectionScheduler = scheduler; }
+    void setDetectionEnabled(bool enabled) { detectionEnabled = enabled; }
+    // Çoklu izlemede frame'lere ve tespit isteklerine yazılan akış kimliği
+    void setStreamId(int id) { streamId = id; }
+    int getStreamId() const { return streamId; }
+    // Seçilen frame'de son gönderilen frame'e göre hareket yoksa tespit atlanır
+    // ve detectionSkipped gönderilir
+    void setMotionGateEnabled(bool enabled) { motionGate.setEnabled(enabled); }
+    quint64 skippedDetections() const { return motionGate.skipped(); }
+    QString getMotionGateInfo() const { return motionGate.getInfo(); }
+
+    // Oynatma hızı. 2x ve üzerinde gösterilmeyecek ara frame'ler sadece grab()
+    // ile geçilir (BGR dönüşümü ve havuz buffer'ı yok), decode edilen frame hızı
+    // videonun kendi fps'inde kalır. Offline analizde kullanılmaz.
+    void setPlaybackRate(double rate);
+    quint64 skippedDecodes() const { return decodesSkipped; }
+
+    // Son gösterilen frame'e göre ileri/geri adım (duraklatılmışken kare kare gezinme)
+    void stepFrames(int delta);
+
+    // Duraklatılmışken yapılan seek ve adımlar önce decode cache'ine bakar,
+    // ardından hareket yönünde prefetchFrames kadar frame önceden decode edilir
+    void setFrameCacheBudget(qint64 bytes);
+    void setPrefetchFrames(int count);
+    QString getCacheInfo() const { return frameCache.getInfo(); }
+
+    // Video açılınca arka planda oluşturulan keyframe index'i, hazır değilse nullptr
+    std::shared_ptr<const FrameIndex> frameIndex() const;
+
+    // Playlist: sıradaki video oynatma sürerken arka planda açılır ve ilk frame'leri
+    // decode edilir. openVideoDirectly aynı dosya için hazırlığı devralır. autoAdvance
+    // açıksa video bitince decode döngüsü beklemeden hazırlanan videoya geçer,
+    // frameId'ler kesintisiz artmaya devam eder ve videoSwitched gönderilir.
+    void preloadVideo(const QString& filePath);
+    QString preloadedVideo() const { return preloader.pendingPath(); }
+    void setAutoAdvance(bool enabled) { autoAdvance = enabled; }
+    // Oynatma sürerken hazırlanan videoya hemen geç (döngü bir sonraki frame'den önce uygular)
+    bool requestSwitchToPreloaded();
 public slots:
     // Bu slotlar thread başladığında veya durdurulmak istendiğinde çağrılacak
     void startProcessing();
@@ -34,22 +100,87 @@ signals:
     void videoOpened(const VideoInfo& videoInfo);
     void videoFinished();
     void progressChanged(double progress);
+    // Keyframe index'i hazır (arka plan thread'inden gönderilir)
+    void indexReady(int keyframeCount);
+    // Seek uygulandı, kuyruktaki frame'ler artık hedef frame'den başlıyor
+    void seekFinished(int frameNumber);
+    // Hareket olmadığı için tespite gönderilmeyen frame (önceki sonuç geçerli)
+    void detectionSkipped(int frameId);
+    // Playlist'te sıradaki videoya geçildi, firstFrameId yeni videonun ilk frame'i
+    void videoSwitched(const VideoInfo& videoInfo, int firstFrameId);
+
+private slots:
+    void processPendingSeek();
 
 private:
+    int applyPendingSeek();
+    bool seekCapture(int targetFrame, bool cacheSkipped = false);
+    bool decodeNext(FrameData& frameData, bool cache = false);
+    void skipForPlaybackRate();
+    bool takePrimedFrame(FrameData& frameData);
+    bool adoptPreloaded(const QString& filePath);
+    bool switchToPreloaded();
+    void prefetchAround(int frameNumber, int direction);
+    void startIndexBuild(const QString& filePath);
+    void stopIndexBuild();
+    std::shared_ptr<const FrameIndex> waitForIndex();
+    bool processSegmented();
+    void deliverFrame(FrameData&& frameData);
     FrameData createFrameData(const cv::Mat& frame);
+    cv::Mat acquireFrameBuffer();
     bool updateVideoInfo();
     void resetVideoInfo();
 
-    cv::VideoCapture videoCapture;
+    std::unique_ptr<cv::VideoCapture> videoCapture; // Playlist geçişinde hazır olanla değiştirilir
     VideoInfo currentVideoInfo;
     int nextFrameId;
 
     // Worker ların iletişim kuracağı kuyruklar
     FrameQueue* displayQueue;
     FrameQueue* detectionQueue;
+    DetectionScheduler* detectionScheduler;
+    std::atomic<bool> detectionEnabled;
+    std::atomic<int> streamId;
+    MotionGate motionGate;
+
+    // Decode buffer'larının alındığı havuz (MainWindow'a ait)
+    FramePool* framePool;
+
+    // Sıradaki video hazırlığı ve ondan devralınan, henüz teslim edilmemiş frame'ler
+    VideoPreloader preloader;
+    std::deque<FrameData> primedFrames;
+    std::atomic<bool> autoAdvance;
+    std::atomic<bool> switchRequested;
 
     // Döngünün çalışıp çalışmadığını kontrol eden thread-safe bayrak
     std::atomic<bool> isRunning;
+
+    // Offline (segment paralel) decode ayarları
+    std::atomic<bool> offlineMode;
+    std::atomic<int> decodeWorkers;
+
+    // Hızlı oynatmada retrieve edilmeden geçilen frame'ler
+    std::atomic<double> playbackRate;
+    std::atomic<quint64> decodesSkipped;
+
+    // Oynatmada decode'un ekranın en fazla kaç frame önünde gidebileceği
+    int maxQueuedFrames;
+
+    // Seek için keyframe index'i. Oluşturma ayrı bir thread'de yapılır.
+    std::thread indexThread;
+    std::mutex captureMutex;                 // videoCapture ve primedFrames (decode döngüsü, duraklatılmış seek, açma/kapama)
+    std::mutex indexThreadMutex;             // indexThread'in başlatılması/beklenmesi
+    mutable std::mutex indexMutex;           // index işaretçisi
+    std::shared_ptr<const FrameIndex> index;
+    std::atomic<bool> indexCancel;
+
+    std::atomic<int> pendingSeekFrame;       // -1: bekleyen seek yok
+    std::atomic<double> videoFps;
+
+    // Geri adım ve scrub için son decode edilen frame'ler
+    FrameCache frameCache;
+    std::atomic<int> prefetchFrames;
+    std::atomic<int> playhead;               // Son teslim edilen frame numarası
 };
 
 #endif // VIDEOCONTROLLER_H
@@ -1,16 +1,30 @@
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
 #include "ai/yolocommunicator.h"
+#include "ai/onnxdetector.h"
+#include "widgets/streamgrid.h"
 #include <qfileinfo.h>
+#include <QShortcut>
+#include <cmath>
+
+namespace {
+constexpr int DisplayTickMs = 4;        // Gösterim saatinin kontrol aralığı
+constexpr double MaxLateMs = 250.0;     // Bundan fazla geride kalınırsa saat frame'e çekilir
+constexpr double MaxAheadMs = 2000.0;   // Zaman damgası sıçrarsa (yeni video, seek) saat yeniden kurulur
+}
 
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
     ui(new Ui::MainWindow),
     videoController(nullptr),
-    yoloCommunicator(nullptr),
+    inferenceBackend(nullptr),
     videoThread(nullptr),
     yoloThread(nullptr),
+    overlayRenderer(nullptr),
+    overlayThread(nullptr),
+    resultExporter(nullptr),
+    exportThread(nullptr),
     displayTimer(nullptr),
     uiUpdateTimer(nullptr),
     isPlaying(false),
@@ -19,9 +33,7 @@ MainWindow::MainWindow(QWidget *parent)
     isYOLOEnabled(false),
     frameCounter(0),
     currentDisplayFPS(0.0),
-    totalDetectionsCount(0),
-    lastDetectionFrameId(-1),
-    DETECTION_PERSISTENCE(15)
+    DETECTION_PERSISTENCE(24)
 {
     ui->setupUi(this);
     setupStatusBar();
@@ -29,11 +41,18 @@ MainWindow::MainWindow(QWidget *parent)
     setupThreads();
 
     displayTimer = new QTimer(this);
+    displayTimer->setTimerType(Qt::PreciseTimer);
     connect(displayTimer, &QTimer::timeout, this, &MainWindow::onDisplayTimer);
 
     uiUpdateTimer = new QTimer(this);
     connect(uiUpdateTimer, &QTimer::timeout, this, &MainWindow::onUIUpdateTimer);
     uiUpdateTimer->start(100);
+
+    // Duraklatılmışken ok tuşlarıyla kare kare gezinme
+    auto* stepBackShortcut = new QShortcut(QKeySequence(Qt::Key_Left), this);
+    connect(stepBackShortcut, &QShortcut::activated, this, [this]() { stepFrame(-1); });
+    auto* stepForwardShortcut = new QShortcut(QKeySequence(Qt::Key_Right), this);
+    connect(stepForwardShortcut, &QShortcut::activated, this, [this]() { stepFrame(1); });
 }
 
 MainWindow::~MainWindow()
@@ -68,6 +87,17 @@ MainWindow::~MainWindow()
             yoloThread->wait(1000);
         }
     }
+
+    if (overlayThread) {
+        overlayThread->quit();
+        overlayThread->wait();
+    }
+
+    // Exporter silinirken bekleyen kayıtları yazıp dosyaları kapatır
+    if (exportThread) {
+        exportThread->quit();
+        exportThread->wait();
+    }
     delete ui;
     qDebug() << "MainWindow: Temizlik tamamlandı";
 }
@@ -93,6 +123,16 @@ void MainWindow::closeEvent(QCloseEvent *event)
         }
     }
 
+    if (overlayThread && overlayThread->isRunning()) {
+        overlayThread->quit();
+        overlayThread->wait();
+    }
+
+    if (exportThread && exportThread->isRunning()) {
+        exportThread->quit();
+        exportThread->wait();
+    }
+
     event->accept();
     qDebug() << "MainWindow: Close event tamamlandı";
 }
@@ -134,28 +174,44 @@ void MainWindow::setupThreads() {
         videoThread->setObjectName("VideoThread");
         yoloThread = new QThread(this);
         yoloThread->setObjectName("YOLOThread");
+        overlayThread = new QThread(this);
+        overlayThread->setObjectName("OverlayThread");
+        exportThread = new QThread(this);
+        exportThread->setObjectName("ExportThread");
 
         // Worker nesnelerini oluştur
-        videoController = new VideoController(&displayQueue);
-        yoloCommunicator = new YOLOCommunicator(&detectionQueue);
+        videoController = new VideoController(&displayQueue, &framePool);
+        videoController->setDetectionQueue(&detectionQueue);
+        videoController->setDetectionScheduler(&detectionScheduler);
+        detectionScheduler.setArbiter(&detectionArbiter, 0);
+        detectionArbiter.setStreamActive(0, true);
+        overlayRenderer = new OverlayRenderer();
+        resultExporter = new ResultExporter();
 
         // Worker'ları thread'lere taşı
         videoController->moveToThread(videoThread);
-        yoloCommunicator->moveToThread(yoloThread);
+        overlayRenderer->moveToThread(overlayThread);
+        resultExporter->moveToThread(exportThread);
 
         // Signal-slot bağlantıları
         setupSignalConnections();
 
         // Thread cleanup bağlantıları
         connect(videoThread, &QThread::finished, videoController, &QObject::deleteLater);
-        connect(yoloThread, &QThread::finished, yoloCommunicator, &QObject::deleteLater);
+        connect(overlayThread, &QThread::finished, overlayRenderer, &QObject::deleteLater);
+        connect(exportThread, &QThread::finished, resultExporter, &QObject::deleteLater);
 
         // Thread'leri başlat
         videoThread->start();
         yoloThread->start();
+        overlayThread->start();
+        exportThread->start();
 
-        // YOLO processing'i başlat (video açıldığında değil, hemen)
-        QMetaObject::invokeMethod(yoloCommunicator, "startProcessing", Qt::QueuedConnection);
+        // Varsayılan backend: Python YOLO servisi (video açıldığında değil, hemen başlar)
+        ui->comboBox_selectModel->blockSignals(true);
+        ui->comboBox_selectModel->addItem("Python YOLO (TCP)", QString());
+        ui->comboBox_selectModel->blockSignals(false);
+        installInferenceBackend(new YOLOCommunicator(&detectionQueue));
 
         qDebug() << "MainWindow: Thread'ler başarıyla kuruldu";
 
@@ -174,14 +230,52 @@ void MainWindow::setupSignalConnections() {
             this, &MainWindow::onVideoFinished, Qt::QueuedConnection);
     connect(videoController, &VideoController::progressChanged,
             this, &MainWindow::onProgressChanged, Qt::QueuedConnection);
+    connect(videoController, &VideoController::seekFinished,
+            this, &MainWindow::onSeekFinished, Qt::QueuedConnection);
+    connect(videoController, &VideoController::indexReady,
+            this, &MainWindow::onIndexReady, Qt::QueuedConnection);
+    connect(videoController, &VideoController::detectionSkipped,
+            this, &MainWindow::onDetectionSkipped, Qt::QueuedConnection);
+    connect(videoController, &VideoController::videoSwitched,
+            this, &MainWindow::onVideoSwitched, Qt::QueuedConnection);
+
+    connect(overlayRenderer, &OverlayRenderer::frameRendered,
+            this, &MainWindow::onOverlayRendered, Qt::QueuedConnection);
+
+    connect(resultExporter, &ResultExporter::errorOccurred,
+            this, &MainWindow::updateStatusBar, Qt::QueuedConnection);
+    connect(resultExporter, &ResultExporter::closed, this, [this](quint64 records, quint64 rows) {
+        updateStatusBar(QString("Sonuçlar yazıldı: %1 frame, %2 tespit").arg(records).arg(rows));
+    }, Qt::QueuedConnection);
+
+    // InferenceBackend sinyalleri installInferenceBackend içinde bağlanır
+}
+
+void MainWindow::installInferenceBackend(InferenceBackend* backend)
+{
+    // Önceki backend'i durdur. stopProcessing sadece atomik bayrağı değiştirir,
+    // döngü meşgulken kuyruklu çağrı işlenmeyeceği için doğrudan çağrılır.
+    if (inferenceBackend) {
+        disconnect(inferenceBackend, nullptr, this, nullptr);
+        inferenceBackend->stopProcessing();
+        inferenceBackend->deleteLater(); // Döngü bitince kendi thread'inde silinir
+        detectionQueue.clear();
+        onYOLOConnectionChanged(false);
+    }
 
-    // YOLOCommunicator signals
-    connect(yoloCommunicator, &YOLOCommunicator::detectionReceived,
+    inferenceBackend = backend;
+    inferenceBackend->moveToThread(yoloThread);
+    connect(yoloThread, &QThread::finished, inferenceBackend, &QObject::deleteLater);
+
+    connect(inferenceBackend, &InferenceBackend::detectionReceived,
             this, &MainWindow::onDetectionReceived, Qt::QueuedConnection);
-    connect(yoloCommunicator, &YOLOCommunicator::connectionStatusChanged,
+    connect(inferenceBackend, &InferenceBackend::connectionStatusChanged,
             this, &MainWindow::onYOLOConnectionChanged, Qt::QueuedConnection);
-    connect(yoloCommunicator, &YOLOCommunicator::errorOccurred,
+    connect(inferenceBackend, &InferenceBackend::errorOccurred,
             this, &MainWindow::onYOLOError, Qt::QueuedConnection);
+
+    QMetaObject::invokeMethod(inferenceBackend, "startProcessing", Qt::QueuedConnection);
+    qDebug() << "MainWindow: Tespit backend'i:" << inferenceBackend->backendName();
 }
 
 void MainWindow::cleanupThreads() {
@@ -191,18 +285,20 @@ void MainWindow::cleanupThreads() {
         QMetaObject::invokeMethod(videoController, "stopProcessing", Qt::QueuedConnection);
     }
 
-    if (yoloCommunicator) {
-        QMetaObject::invokeMethod(yoloCommunicator, "stopProcessing", Qt::QueuedConnection);
+    if (inferenceBackend) {
+        inferenceBackend->stopProcessing();
     }
+    stopExtraStreams();
 
     // Queue'ları temizle
     displayQueue.clear();
     detectionQueue.clear();
 }
 
-void MainWindow::startVideoProcessing(const QString& videoPath) {
+void MainWindow::startVideoProcessing(const QString& videoPath, bool offline) {
     // Önce durdur
     stopVideoProcessing();
+    setMultiStreamView(1); // Çoklu izleme startMultiStream'de tekrar açılır
 
     updateStatusBar("Video açılıyor...");
 
@@ -210,13 +306,28 @@ void MainWindow::startVideoProcessing(const QString& videoPath) {
     if (videoController->openVideoDirectly(videoPath)) {
         isVideoLoaded = true;
         isPlaying = true;
+        isOfflineRun = offline;
         ui->pushButton_PlayPause->setText("Pause");
-        displayTimer->start(33);
+        presentationClock.reset();
+        presentationClock.setRate(ui->doubleSpinBox_PlaybackSpeed->value());
+        videoController->setPlaybackRate(ui->doubleSpinBox_PlaybackSpeed->value());
+        displayTimer->start(DisplayTickMs);
+
+        // Offline analizin sonuçları video ile aynı klasöre <video>.detections.csv/.jsonl olarak yazılır
+        if (offline) {
+            const QFileInfo info(videoPath);
+            const QString basePath = info.absolutePath() + "/" + info.completeBaseName() + ".detections";
+            QMetaObject::invokeMethod(resultExporter, "open", Qt::QueuedConnection,
+                                      Q_ARG(QString, basePath),
+                                      Q_ARG(int, ResultExporter::Csv | ResultExporter::JsonLines));
+            isExporting = true;
+        }
 
         // Sonra processing'i thread'de başlat
+        videoController->setOfflineMode(offline);
         QMetaObject::invokeMethod(videoController, "startProcessing", Qt::QueuedConnection);
 
-        updateStatusBar("Video oynatılıyor");
+        updateStatusBar(offline ? "Video analiz ediliyor (offline)" : "Video oynatılıyor");
     } else {
         updateStatusBar("Hata: Video açılamadı");
     }
@@ -224,16 +335,206 @@ void MainWindow::startVideoProcessing(const QString& videoPath) {
 void MainWindow::stopVideoProcessing() {
     if (displayTimer) displayTimer->stop();
     if (videoController) {
-        QMetaObject::invokeMethod(videoController, "stopProcessing", Qt::QueuedConnection);
+        // Decode döngüsü meşgulken kuyruklu çağrı işlenmez, bayrak atomik olduğu için
+        // doğrudan çağrılır
+        videoController->stopProcessing();
+        videoController->setAutoAdvance(false);
     }
+    stopExtraStreams();
 
     displayQueue.clear();
     detectionQueue.clear();
 
+    if (isExporting) {
+        // Sonucu beklenen frame'ler eldeki sonuçlarla yazılır, ardından dosyalar kapanır
+        flushPendingExports(true);
+        QMetaObject::invokeMethod(resultExporter, "close", Qt::QueuedConnection);
+        isExporting = false;
+    }
+    pendingExports.clear();
+    lastExported = DetectionResult();
+    exportDraining = false;
+
+    pendingFrame = FrameData();
+    hasPendingFrame = false;
+    presentationClock.reset();
+    lastPresentedFrameId = -1; // Yeni videoda frameId'ler sıfırdan başlar
+    detectionStore.clear();
+    detectionScheduler.reset();
+    objectTracker.clear();
+    motionAnalyzer.clear();
+
     isPlaying = false;
     isVideoLoaded = false;
+    isOfflineRun = false;
     ui->pushButton_PlayPause->setText("Play");
 }
+
+void MainWindow::preloadNextVideo()
+{
+    // Oynatılan videodan sonraki liste elemanı arka planda hazırlanır. Video bitince
+    // decode döngüsü ona kendisi geçer, seçilirse de açılış beklenmez.
+    const int index = videoFilesList.indexOf(currentVideoPath);
+    const bool playlist = isVideoLoaded && !isOfflineRun && !isMultiStream;
+    const QString nextPath = playlist && index >= 0 && index + 1 < videoFilesList.size()
+                                 ? videoFilesList[index + 1] : QString();
+
+    videoController->setAutoAdvance(!nextPath.isEmpty());
+    videoController->preloadVideo(nextPath);
+}
+
+void MainWindow::startMultiStream(const QStringList& videoPaths)
+{
+    // Ana video (streamId 0) normal yoldan açılır: slider, durum çubuğu ve hareket
+    // analizi ona bağlıdır. Diğer videolar ayrı thread'lerde yanında oynatılır.
+    const QStringList paths = videoPaths.mid(0, MaxGridStreams);
+    startVideoProcessing(paths.first());
+    if (!isVideoLoaded) {
+        return;
+    }
+
+    setMultiStreamView(paths.size());
+    for (int i = 1; i < paths.size(); ++i) {
+        if (!startExtraStream(paths[i], i)) {
+            qDebug() << "MainWindow: Akış açılamadı:" << paths[i];
+        }
+    }
+    updateStatusBar(QString("Çoklu izleme: %1 video").arg(extraStreams.size() + 1));
+}
+
+bool MainWindow::startExtraStream(const QString& videoPath, int streamId)
+{
+    auto session = std::make_unique<StreamSession>();
+    session->streamId = streamId;
+    session->videoPath = videoPath;
+    session->thread = new QThread(this);
+    session->thread->setObjectName(QString("VideoThread%1").arg(streamId));
+
+    // Tespit kuyruğu ve backend ana video ile ortak, sırayı arbiter belirler
+    session->controller = new VideoController(&session->displayQueue, &session->framePool);
+    session->controller->setStreamId(streamId);
+    session->controller->setDetectionQueue(&detectionQueue);
+    session->controller->setDetectionScheduler(&session->scheduler);
+    session->controller->setDetectionEnabled(isYOLOEnabled && isYOLOConnected);
+    session->scheduler.setArbiter(&detectionArbiter, streamId);
+    session->controller->moveToThread(session->thread);
+    connect(session->thread, &QThread::finished, session->controller, &QObject::deleteLater);
+
+    // Oturum kapandıktan sonra gelen sinyaller findStream ile elenir
+    connect(session->controller, &VideoController::detectionSkipped, this, [this, streamId](int frameId) {
+        if (StreamSession* stream = findStream(streamId)) {
+            stream->store.carryForward(frameId);
+        }
+    }, Qt::QueuedConnection);
+    connect(session->controller, &VideoController::videoFinished, this, [this, streamId]() {
+        // Biten akışın tespit payı diğerlerine kalır
+        detectionArbiter.setStreamActive(streamId, false);
+    }, Qt::QueuedConnection);
+
+    session->thread->start();
+    if (!session->controller->openVideoDirectly(videoPath)) {
+        session->thread->quit();
+        session->thread->wait();
+        delete session->thread;
+        return false;
+    }
+
+    session->clock.setRate(ui->doubleSpinBox_PlaybackSpeed->value());
+    session->controller->setPlaybackRate(ui->doubleSpinBox_PlaybackSpeed->value());
+    detectionArbiter.setStreamActive(streamId, true);
+    if (isPlaying) {
+        QMetaObject::invokeMethod(session->controller, "startProcessing", Qt::QueuedConnection);
+    }
+    extraStreams.push_back(std::move(session));
+    return true;
+}
+
+void MainWindow::stopExtraStreams()
+{
+    if (extraStreams.empty()) {
+        return;
+    }
+
+    // Önce tüm decode döngüleri durdurulur, sonra thread'ler beklenir
+    for (const auto& session : extraStreams) {
+        session->controller->stopProcessing();
+        detectionArbiter.setStreamActive(session->streamId, false);
+    }
+    for (const auto& session : extraStreams) {
+        session->thread->quit();
+        if (!session->thread->wait(3000)) {
+            qDebug() << "Akış thread'i zorla sonlandırılıyor:" << session->streamId;
+            session->thread->terminate();
+            session->thread->wait(1000);
+        }
+        delete session->thread; // Controller finished sinyali ile silindi
+        session->displayQueue.clear();
+    }
+    extraStreams.clear();
+    if (streamGrid) {
+        streamGrid->clearFrames();
+    }
+}
+
+void MainWindow::presentStream(StreamSession& session)
+{
+    FrameData frameData;
+    if (!takeDueFrame(session.displayQueue, session.clock, session.pendingFrame,
+                      session.hasPendingFrame, session.lateFramesDropped, frameData)) {
+        return;
+    }
+
+    DetectionResult detections;
+    if (session.store.resolve(frameData.frameId, DETECTION_PERSISTENCE, detections, &session.tracker)) {
+        overlayRenderer->submit(frameData, detections); // Çizilen frame onOverlayRendered'a gelir
+        return;
+    }
+    session.lastPresentedFrameId = frameData.frameId;
+    if (VideoView* view = viewForStream(session.streamId)) {
+        view->setFrame(frameData.frame);
+    }
+}
+
+StreamSession* MainWindow::findStream(int streamId) const
+{
+    for (const auto& session : extraStreams) {
+        if (session->streamId == streamId) {
+            return session.get();
+        }
+    }
+    return nullptr;
+}
+
+void MainWindow::setMultiStreamView(int streamCount)
+{
+    isMultiStream = streamCount > 1;
+    if (!isMultiStream) {
+        if (streamGrid) {
+            streamGrid->hide();
+            streamGrid->setStreamCount(0);
+        }
+        ui->videoView->show();
+        return;
+    }
+
+    if (!streamGrid) {
+        // Izgara videoView'in yerini alır
+        streamGrid = new StreamGrid(ui->videoView->parentWidget());
+        streamGrid->setGeometry(ui->videoView->geometry());
+    }
+    streamGrid->setStreamCount(streamCount);
+    ui->videoView->hide();
+    streamGrid->show();
+}
+
+VideoView* MainWindow::viewForStream(int streamId) const
+{
+    if (!isMultiStream) {
+        return streamId == 0 ? ui->videoView : nullptr;
+    }
+    return streamGrid->view(streamId);
+}
+
 void MainWindow::setupTimers()
 {
 
@@ -250,29 +551,95 @@ void MainWindow::setupTimers()
 
 void MainWindow::onDisplayTimer()
 {
-    if (displayQueue.empty()) {
-        return;
+    for (const auto& session : extraStreams) {
+        presentStream(*session);
     }
 
-    FrameData frameData = displayQueue.pop();
-    if (!frameData.isValid()) return;
+    FrameData frameData;
+
+    if (isOfflineRun) {
+        // Offline analizde decode ekrandan hızlıdır ve saat kullanılmaz: ekranda
+        // sadece en son frame gösterilir (tespit istekleri decode anında gönderildi)
+        if (!displayQueue.try_pop(frameData) || !frameData.isValid()) {
+            checkExportDrained();
+            return;
+        }
+        // Ekrana gelmeyen frame'ler de sonuçları geldiğinde dışa aktarılır
+        queueExport(frameData);
+        FrameData newer;
+        while (displayQueue.try_pop(newer)) {
+            frameCounter++;
+            frameData = std::move(newer);
+            queueExport(frameData);
+        }
+        flushPendingExports(false);
+    } else if (!takeDueFrame(displayQueue, presentationClock, pendingFrame,
+                             hasPendingFrame, lateFramesDropped, frameData)) {
+        return;
+    }
 
     currentFrameData = frameData; // Güncel kareyi sakla
     frameCounter++; // Sayacı burada artırmak daha mantıklı
 
-    // 1. Her kareyi ekranda göster
+    // Her kareyi ekranda göster. Tespit istekleri VideoController'da decode anında gönderilir.
     displayFrame(frameData);
+}
+
+bool MainWindow::takeDueFrame(FrameQueue& queue, PresentationClock& clock, FrameData& pending,
+                              bool& hasPending, quint64& lateDropped, FrameData& frameToShow)
+{
+    // Gösterim zamanı gelmiş en yeni frame seçilir. Zamanı geçmiş ara frame'ler
+    // kuyrukta birikmek yerine atlanır, böylece ekran gecikmesi sınırlı kalır.
+    // Çoklu izlemede her akış kendi kuyruğu ve saati ile çağırır.
+    bool haveFrame = false;
+    for (;;) {
+        if (!hasPending) {
+            if (!queue.try_pop(pending)) break;
+            if (!pending.isValid()) continue;
+            hasPending = true;
+            if (!clock.isStarted()) {
+                clock.start(pending.timeStamp);
+            }
+        }
+
+        const double waitMs = clock.msUntil(pending.timeStamp);
+        if (std::abs(waitMs) > MaxAheadMs) {
+            // Zaman damgası sıçradı (seek, playlist'te sıradaki video). Elde frame
+            // varsa önce o gösterilir, saat sonraki tick'te bu frame'den yeniden başlar.
+            if (haveFrame) break;
+            clock.start(pending.timeStamp);
+        } else if (waitMs > 0) {
+            break; // Henüz zamanı gelmedi, sonraki tick'te tekrar bakılır
+        }
 
-    // 2. AI analizi aktifse ve doğru karedeysek, tespit kuyruğuna gönder
-    if (isYOLOEnabled && isYOLOConnected && (frameCounter % 6 == 0)) {
-        qDebug() << "MainWindow: Frame" << frameData.frameId << "tespit için yönlendiriliyor.";
-        detectionQueue.push(frameData);
+        if (haveFrame) {
+            lateDropped++;
+        }
+        frameToShow = std::move(pending);
+        pending = FrameData();
+        hasPending = false;
+        haveFrame = true;
+    }
+
+    // Decode gerçek zamana yetişemiyorsa saat frame'lerin çok önüne geçer. Saat
+    // gösterilen frame'e çekilir, yoksa sonraki frame'lerin hepsi geç kalmış sayılırdı.
+    if (haveFrame && clock.msUntil(frameToShow.timeStamp) < -MaxLateMs) {
+        clock.start(frameToShow.timeStamp);
     }
+    return haveFrame;
 }
 
 void MainWindow::onVideoFinished()
 {
     QMetaObject::invokeMethod(this, [this](){
+        if (isExporting) {
+            // Ekran kuyruğundaki ve tespitteki son frame'ler yazılmadan dosyalar kapanmaz,
+            // checkExportDrained bitişi gösterim timer'ında denetler
+            exportDraining = true;
+            exportIdleTimer.start();
+            updateStatusBar("Son tespit sonuçları bekleniyor...");
+            return;
+        }
         updateStatusBar("Video tamamlandı");
         stopVideoProcessing();
     }, Qt::QueuedConnection);
@@ -304,9 +671,41 @@ void MainWindow::on_pushButton_selectVideo_clicked()
 
     // Video dosyasını aç
     QString selectedVideoPath = videoFilesList[selectedRow];
-    startVideoProcessing(selectedVideoPath);
-    isVideoLoaded = true;
+
+    // Oynatma sürerken hazırlanmış video seçildiyse decode döngüsü durdurulmadan ona geçer
+    if (isPlaying && !isOfflineRun && !isMultiStream &&
+        selectedVideoPath == videoController->preloadedVideo() &&
+        videoController->requestSwitchToPreloaded()) {
+        return; // Arayüz onVideoSwitched'de güncellenir
+    }
+
     currentVideoPath = selectedVideoPath;
+    startVideoProcessing(selectedVideoPath);
+    preloadNextVideo();
+}
+
+void MainWindow::on_pushButton_Process_clicked()
+{
+    // Seçili videoyu ekran hızına bağlı kalmadan, segment paralel decode ile analiz et
+    int selectedRow = ui->listWidget_Videos->currentRow();
+    if (selectedRow < 0 || selectedRow >= videoFilesList.size()) {
+        updateStatusBar("Önce video seçin");
+        return;
+    }
+
+    currentVideoPath = videoFilesList[selectedRow];
+    startVideoProcessing(currentVideoPath, true);
+}
+
+void MainWindow::on_pushButton_MultiStream_clicked()
+{
+    // Listedeki ilk MaxGridStreams video ızgarada aynı anda oynatılır
+    if (videoFilesList.size() < 2) {
+        updateStatusBar("Çoklu izleme için listeye en az 2 video ekleyin");
+        return;
+    }
+    currentVideoPath = videoFilesList.first();
+    startMultiStream(videoFilesList);
 }
 
 void MainWindow::on_listWidget_Videos_itemDoubleClicked(QListWidgetItem *item)
@@ -326,14 +725,24 @@ void MainWindow::on_pushButton_PlayPause_clicked() {
     if (isPlaying) {
         // Pause
         displayTimer->stop();
-        QMetaObject::invokeMethod(videoController, "stopProcessing", Qt::QueuedConnection);
+        videoController->stopProcessing();
+        presentationClock.pause();
+        for (const auto& session : extraStreams) {
+            session->controller->stopProcessing();
+            session->clock.pause();
+        }
         isPlaying = false;
         ui->pushButton_PlayPause->setText("Play");
         updateStatusBar("Video duraklatıldı");
     } else {
         // Play
-        displayTimer->start(33);
+        presentationClock.resume();
+        displayTimer->start(DisplayTickMs);
         QMetaObject::invokeMethod(videoController, "startProcessing", Qt::QueuedConnection);
+        for (const auto& session : extraStreams) {
+            session->clock.resume();
+            QMetaObject::invokeMethod(session->controller, "startProcessing", Qt::QueuedConnection);
+        }
         isPlaying = true;
         ui->pushButton_PlayPause->setText("Pause");
         updateStatusBar("Video oynatılıyor");
@@ -346,31 +755,39 @@ void MainWindow::on_doubleSpinBox_PlaybackSpeed_valueChanged(double value)
 {
     if (value <= 0) return; // Sıfıra bölme hatasını önle
 
-    const double baseInterval = 33.0;
-    int newInterval = static_cast<int>(baseInterval / value);
-
-    if (displayTimer) {
-        displayTimer->setInterval(qMax(1, newInterval)); // Minimum 1ms
+    // Saat o anki video zamanından yeni hızla devam eder, decode da gösterilmeyecek
+    // frame'leri atlamak için hızı bilir
+    presentationClock.setRate(value);
+    videoController->setPlaybackRate(value);
+    for (const auto& session : extraStreams) {
+        session->clock.setRate(value);
+        session->controller->setPlaybackRate(value);
     }
 }
 
  void MainWindow::on_horizontalSlider_sliderMoved(int position)
 {
-    if (!isVideoLoaded) {
+    // Offline analizde segment decode seek desteklemez
+    if (!isVideoLoaded || isOfflineRun) {
         return;
     }
 
-    // Slider pozisyonunu frame numarasına çevir
-    //int totalFrames = videoController->getTotalFrames();
-    //int targetFrame = (position * totalFrames) / 100;
+    // Slider aralığı frame sayısıdır, pozisyon doğrudan frame numarasıdır
+    videoController->seekToFrame(position);
+}
 
-    // Frame e git
-    //videoController->seekToFrame(targetFrame);
+void MainWindow::stepFrame(int delta)
+{
+    if (!isVideoLoaded || isPlaying || isOfflineRun) {
+        return;
+    }
+    // Geri adımlar VideoController'ın decode cache'inden karşılanır
+    videoController->stepFrames(delta);
 }
 
 void MainWindow::on_pushButton_SystemStatus_clicked()
 {
-    // showDebugInfo();
+    showDebugInfo();
 }
 
 // VİDEO CONTROLLER SLOTLARI
@@ -381,8 +798,8 @@ void MainWindow::onVideoOpened(const VideoInfo& videoInfo)
 
     updateVideoInfo(videoInfo);  // Video bilgilerini UI da göster
 
-    // Slider ayarla
-    ui->horizontalSlider->setRange(0, 100);
+    // Slider ayarla (frame hassasiyetinde seek için her adım bir frame)
+    ui->horizontalSlider->setRange(0, qMax(0, videoInfo.totalFrames - 1));
     ui->horizontalSlider->setValue(0);
 
     // Status güncelle
@@ -395,6 +812,78 @@ void MainWindow::onProgressChanged(double progress)
     updateSeekSlider(progress); // Slider güncelle
 }
 
+void MainWindow::onSeekFinished(int frameNumber)
+{
+    // Seek öncesinden kalan frame gösterilmez, saat hedef frame'den yeniden başlar
+    pendingFrame = FrameData();
+    hasPendingFrame = false;
+    presentationClock.reset();
+    objectTracker.clear(); // Seek sonrası sahne değişir, eski izler eşleşmemeli
+    motionAnalyzer.clear();
+
+    // Duraklatılmışken gösterim timer'ı çalışmadığı için hedef frame burada gösterilir
+    if (!isPlaying) {
+        FrameData frameData;
+        FrameData newer;
+        while (displayQueue.try_pop(newer)) {
+            frameData = std::move(newer);
+        }
+        if (frameData.isValid()) {
+            currentFrameData = frameData;
+            displayFrame(frameData);
+        }
+    }
+    updateStatusBar(QString("Frame %1").arg(frameNumber));
+}
+
+void MainWindow::onVideoSwitched(const VideoInfo& videoInfo, int firstFrameId)
+{
+    // Kuyrukta önceki videonun son frame'leri olabilir, gösterim kesilmez.
+    // Zaman damgası sıçraması takeDueFrame'de saati yeniden kurar.
+    currentVideoPath = videoInfo.filePath;
+    const int index = videoFilesList.indexOf(currentVideoPath);
+    if (index >= 0) {
+        ui->listWidget_Videos->setCurrentRow(index);
+    }
+    updateVideoInfo(videoInfo);
+    ui->horizontalSlider->setRange(0, qMax(0, videoInfo.totalFrames - 1));
+    ui->horizontalSlider->setValue(0);
+
+    // Önceki videonun izleri ve tespitleri yeni sahneye taşınmaz
+    objectTracker.clear();
+    motionAnalyzer.clear();
+    detectionStore.beginSegment(firstFrameId);
+
+    preloadNextVideo();
+    updateStatusBar(QString("Sıradaki video: %1").arg(videoInfo.fileName));
+}
+
+void MainWindow::onOverlayRendered(const FrameData& frameData)
+{
+    int* lastPresented = &lastPresentedFrameId;
+    if (frameData.streamId != 0) {
+        StreamSession* session = findStream(frameData.streamId);
+        if (!session) {
+            return; // Akış kapatıldı
+        }
+        lastPresented = &session->lastPresentedFrameId;
+    }
+
+    // Çizim sürerken daha yeni bir frame doğrudan gösterildiyse bu sonuç eskidir
+    if (frameData.frameId < *lastPresented) {
+        return;
+    }
+    *lastPresented = frameData.frameId;
+    if (VideoView* view = viewForStream(frameData.streamId)) {
+        view->setFrame(frameData.frame);
+    }
+}
+
+void MainWindow::onIndexReady(int keyframeCount)
+{
+    qDebug() << "MainWindow: Seek index'i hazır," << keyframeCount << "keyframe";
+}
+
 ////////////////////////////////
 
 void MainWindow::onUIUpdateTimer()
@@ -409,7 +898,11 @@ void MainWindow::onUIUpdateTimer()
 
         // Performance label'ı güvenli güncelle
         if (performanceLabel) {
-            performanceLabel->setText(QString("FPS: %1").arg(currentDisplayFPS, 0, 'f', 1));
+            QString performance = QString("FPS: %1").arg(currentDisplayFPS, 0, 'f', 1);
+            if (videoController && videoController->skippedDetections() > 0) {
+                performance += QString(" | Atlanan tespit: %1").arg(videoController->skippedDetections());
+            }
+            performanceLabel->setText(performance);
         }
 
         // Memory usage güncelle
@@ -418,11 +911,6 @@ void MainWindow::onUIUpdateTimer()
             memoryUsageBar->setValue(static_cast<int>(memoryUsage));
         }
 
-        // Cache temizliği
-        if (frameCounter % 500 == 0) { // Her 500 frame'de bir
-            cleanupDetectionCache();
-        }
-
     } catch (const std::exception& e) {
         qDebug() << "UI update hatası:" << e.what();
     }
@@ -432,41 +920,16 @@ void MainWindow::displayFrame(const FrameData& frameData) {
     try {
         if (frameData.frame.empty()) return;
 
-        cv::Mat displayMat = frameData.frame;
         DetectionResult detectionToShow;
-        bool shouldShowDetection = false;
-
-        // Detection kontrolü
-        if (detectionResults.contains(frameData.frameId)) {
-            detectionToShow = detectionResults[frameData.frameId];
-            shouldShowDetection = true;
-        }
-        else if (lastValidDetection.isValid() && lastDetectionFrameId >= 0) {
-            int frameDiff = frameData.frameId - lastDetectionFrameId;
-            if (frameDiff >= 0 && frameDiff <= DETECTION_PERSISTENCE) {
-                detectionToShow = lastValidDetection;
-                shouldShowDetection = true;
-            }
-        }
+        const bool shouldShowDetection = analyzeFrame(frameData, detectionToShow);
 
-        // Detection çiz
+        // Tespit varsa çizim OverlayThread'de yapılır, hazır frame onOverlayRendered'a gelir.
+        // Tespit yoksa buffer kopyalanmadan hemen gösterilir.
         if (shouldShowDetection) {
-            try {
-                displayMat = frameData.frame.clone();
-                drawDetections(displayMat, detectionToShow);
-            } catch (const cv::Exception& e) {
-                displayMat = frameData.frame;
-            }
-        }
-
-        // Display - debug'sız
-        QPixmap pixmap = matToQPixmap(displayMat);
-        if (!pixmap.isNull()) {
-            ui->label_VideoDisplay->setPixmap(
-                pixmap.scaled(ui->label_VideoDisplay->size(),
-                              Qt::KeepAspectRatio,
-                              Qt::SmoothTransformation)
-                );
+            overlayRenderer->submit(frameData, detectionToShow);
+        } else {
+            lastPresentedFrameId = frameData.frameId;
+            viewForStream(0)->setFrame(frameData.frame);
         }
 
         updateFrameInfo(frameData, shouldShowDetection, detectionToShow);
@@ -476,46 +939,111 @@ void MainWindow::displayFrame(const FrameData& frameData) {
     }
 }
 
-QPixmap MainWindow::matToQPixmap(const cv::Mat& frame) {
-    try {
-        if (frame.empty() || frame.cols <= 0 || frame.rows <= 0) {
-            return QPixmap();
-        }
-
-        QImage qimg;
+bool MainWindow::analyzeFrame(const FrameData& frameData, DetectionResult& detections)
+{
+    // Tespit edilmemiş frame'ler için kutular komşu sonuçlar arasında ara değerlenir,
+    // sonraki sonuç henüz yoksa tracker tahmini kullanılır
+    const bool hasDetection = detectionStore.resolve(frameData.frameId, DETECTION_PERSISTENCE,
+                                                     detections, &objectTracker);
+    if (!hasDetection) {
+        detections = DetectionResult();
+    }
+    // Offline analizde hareket bilgisi frame sırasıyla flushPendingExports'ta güncellenir
+    if (!isOfflineRun) {
+        motionAnalyzer.update(detections, frameData.timeStamp);
+        detectionScheduler.setSceneActive(motionAnalyzer.movingCount() > 0); // Hareket yoksa daha seyrek tespit
+    }
+    return hasDetection;
+}
 
-        if (frame.channels() == 3) {
-            cv::Mat rgbFrame;
-            cv::cvtColor(frame, rgbFrame, cv::COLOR_BGR2RGB);
+void MainWindow::exportFrame(const FrameData& frameData, const DetectionResult& detections)
+{
+    if (!isExporting) {
+        return;
+    }
 
-            if (rgbFrame.type() != CV_8UC3) {
-                rgbFrame.convertTo(rgbFrame, CV_8UC3);
-            }
+    // Biçimlendirme ve disk yazma ExportThread'de yapılır
+    ExportRecord record;
+    record.frameId = frameData.frameId;
+    record.frameNumber = frameData.frameNumber;
+    record.timeStamp = frameData.timeStamp;
+    record.result = detections;
+    record.motion.resize(detections.detections.size());
+    for (int i = 0; i < detections.detections.size(); ++i) {
+        motionAnalyzer.motion(detections.detections[i].trackId, record.motion[i]);
+    }
+    resultExporter->submit(std::move(record));
+}
 
-            qimg = QImage(rgbFrame.data, rgbFrame.cols, rgbFrame.rows,
-                          rgbFrame.step[0], QImage::Format_RGB888);
-            qimg = qimg.copy();
+void MainWindow::queueExport(const FrameData& frameData)
+{
+    if (!isExporting) {
+        return;
+    }
+    PendingExport& pending = pendingExports[frameData.frameId];
+    pending.header.frameId = frameData.frameId;
+    pending.header.streamId = frameData.streamId;
+    pending.header.frameNumber = frameData.frameNumber;
+    pending.header.timeStamp = frameData.timeStamp;
+    pending.hasHeader = true;
+}
 
-        } else if (frame.channels() == 1) {
-            cv::Mat grayFrame = frame;
-            if (grayFrame.type() != CV_8UC1) {
-                grayFrame.convertTo(grayFrame, CV_8UC1);
+void MainWindow::flushPendingExports(bool force)
+{
+    // Frame'ler sırayla ve yalnızca sonucu kesinleşince yazılır, böylece çıktı
+    // zamanlamaya bağlı değildir. Sonuçlar gönderim sırasıyla geldiği için daha
+    // yeni bir frame'in sonucu geldiyse öncekininki ya geldi ya da hiç gelmeyecek
+    // (hata, zaman aşımı, bağlantı yokken gönderilmedi); o frame komşu sonuçlardan
+    // ara değerlenir. force: video bitti ya da durduruldu, beklenmez.
+    while (!pendingExports.empty()) {
+        const auto it = pendingExports.begin();
+        const int frameId = it->first;
+        const PendingExport& pending = it->second;
+        if (!pending.hasHeader) {
+            if (!force) {
+                break; // Frame henüz ekran kuyruğundan alınmadı
             }
-            qimg = QImage(grayFrame.data, grayFrame.cols, grayFrame.rows,
-                          grayFrame.step[0], QImage::Format_Grayscale8);
-            qimg = qimg.copy();
-        } else {
-            return QPixmap();
+            pendingExports.erase(it);
+            continue;
         }
 
-        if (qimg.isNull()) return QPixmap();
+        DetectionResult detections;
+        if (const DetectionResult* exact = detectionStore.find(frameId)) {
+            detections = *exact;
+        } else if (pending.skipped) {
+            detections = lastExported; // Sahne değişmedi: önceki frame'in sonucu geçerli
+        } else if (force || detectionStore.latestFrameId() > frameId) {
+            detectionStore.resolve(frameId, DETECTION_PERSISTENCE, detections);
+        } else {
+            break; // Sonuç bekleniyor
+        }
+        if (detections.frameId < 0) {
+            detections.frameId = frameId;
+        }
 
-        return QPixmap::fromImage(qimg);
+        motionAnalyzer.update(detections, pending.header.timeStamp);
+        exportFrame(pending.header, detections);
+        lastExported = detections;
+        pendingExports.erase(it);
+    }
+}
 
-    } catch (...) {
-        return QPixmap();
+void MainWindow::checkExportDrained()
+{
+    if (!exportDraining || !displayQueue.empty()) {
+        return;
     }
+    // Backend bağlı değilse ya da uzun süredir sonuç gelmiyorsa beklenmez
+    const bool waiting = !pendingExports.empty() && isYOLOEnabled && isYOLOConnected &&
+                         exportIdleTimer.elapsed() < EXPORT_DRAIN_TIMEOUT_MS;
+    if (waiting) {
+        return;
+    }
+    exportDraining = false;
+    updateStatusBar("Video tamamlandı");
+    stopVideoProcessing();
 }
+
 QString MainWindow::selectVideoFile()
 {
     QString filter = "Video Files (*.mp4 *.avi *.mkv *.mov *.wmv *.flv *.webm);;All Files (*.*)";
@@ -535,6 +1063,11 @@ void MainWindow::addVideoToList(const QString& filePath)
     if (videoFilesList.size() == 1) {
         ui->pushButton_selectVideo->setEnabled(true);
     }
+
+    // Son video oynatılıyorsa yeni eklenen sıradaki olur
+    if (isPlaying && !isOfflineRun && !isMultiStream) {
+        preloadNextVideo();
+    }
 }
 
 void MainWindow::updateStatusBar(const QString& message)
@@ -542,6 +1075,48 @@ void MainWindow::updateStatusBar(const QString& message)
     statusLabel->setText(message);
 }
 
+void MainWindow::showDebugInfo()
+{
+    qDebug() << "=== SİSTEM DURUMU ===";
+    qDebug() << "Display:" << displayQueue.getInfo();
+    qDebug() << "Detection:" << detectionQueue.getInfo();
+    qDebug() << framePool.getInfo();
+    if (const auto index = videoController ? videoController->frameIndex() : nullptr) {
+        qDebug() << index->getInfo();
+    }
+    if (videoController) {
+        qDebug() << videoController->getCacheInfo();
+        qDebug() << videoController->getMotionGateInfo();
+        qDebug() << "Hızlı oynatmada atlanan decode:" << videoController->skippedDecodes();
+    }
+    if (overlayRenderer) {
+        qDebug() << overlayRenderer->getInfo();
+    }
+    qDebug() << detectionStore.getInfo();
+    qDebug() << detectionScheduler.getInfo();
+    if (!extraStreams.empty()) {
+        qDebug() << detectionArbiter.getInfo();
+        for (const auto& session : extraStreams) {
+            qDebug() << "Akış" << session->streamId << session->videoPath;
+            qDebug() << "  Display:" << session->displayQueue.getInfo();
+            qDebug() << " " << session->scheduler.getInfo();
+            qDebug() << " " << session->store.getInfo();
+            qDebug() << " " << session->clock.getInfo() << "Geç kalan (atlanan) frame:" << session->lateFramesDropped;
+        }
+    }
+    qDebug() << objectTracker.getInfo();
+    qDebug() << motionAnalyzer.getInfo();
+    qDebug() << resultExporter->getInfo();
+    qDebug() << presentationClock.getInfo() << "Geç kalan (atlanan) frame:" << lateFramesDropped;
+    if (inferenceBackend) {
+        qDebug() << inferenceBackend->getStatus();
+    }
+
+    updateStatusBar(QString("Pool: %1 hit / %2 miss")
+                        .arg(framePool.hits())
+                        .arg(framePool.misses()));
+}
+
 double MainWindow::calculateMemoryUsage()
 {
     // Basit memory usage hesaplama
@@ -578,7 +1153,11 @@ void MainWindow::updatePerformanceInfo(const PerformanceStats& stats)
 
 void MainWindow::updateSeekSlider(double progress)
 {
-    int sliderValue = static_cast<int>(progress * 100);
+    // Kullanıcı sürüklerken slider'ı geri çekme
+    if (ui->horizontalSlider->isSliderDown()) {
+        return;
+    }
+    int sliderValue = static_cast<int>(progress * ui->horizontalSlider->maximum());
     ui->horizontalSlider->blockSignals(true);
     ui->horizontalSlider->setValue(sliderValue);
     ui->horizontalSlider->blockSignals(false);
@@ -587,6 +1166,7 @@ void MainWindow::updateSeekSlider(double progress)
 void MainWindow::on_pushButton_ChooseModel_clicked()
 {
     isYOLOEnabled = !isYOLOEnabled; // Sadece bayrağı tersine çevir
+    updateDetectionForwarding();
 
     if (isYOLOEnabled) {
         qDebug() << "MainWindow: YOLO analizi AKTİF.";
@@ -597,34 +1177,89 @@ void MainWindow::on_pushButton_ChooseModel_clicked()
         ui->pushButton_ChooseModel->setText("YOLO Analizi: Pasif");
     }
 }
+void MainWindow::on_pushButton_addModel_clicked()
+{
+    // Süreç içi çalıştırılacak ONNX modeli seç (örn. yolov8n.onnx)
+    QString modelPath = QFileDialog::getOpenFileName(this, "ONNX Model Seç", QString(),
+                                                     "ONNX Model (*.onnx);;All Files (*.*)");
+    if (modelPath.isEmpty()) {
+        return;
+    }
+
+    int index = ui->comboBox_selectModel->findData(modelPath);
+    if (index < 0) {
+        ui->comboBox_selectModel->addItem(QFileInfo(modelPath).fileName() + " (ONNX)", modelPath);
+        index = ui->comboBox_selectModel->count() - 1;
+    }
+    ui->comboBox_selectModel->setCurrentIndex(index); // Backend değişimi sinyal ile yapılır
+}
+
+void MainWindow::on_comboBox_selectModel_currentIndexChanged(int index)
+{
+    if (index < 0 || !yoloThread) {
+        return;
+    }
+
+    const QString modelPath = ui->comboBox_selectModel->itemData(index).toString();
+    if (modelPath.isEmpty()) {
+        installInferenceBackend(new YOLOCommunicator(&detectionQueue));
+    } else {
+        installInferenceBackend(new OnnxDetector(&detectionQueue, modelPath));
+    }
+    updateStatusBar(QString("Model: %1").arg(inferenceBackend->backendName()));
+}
+
 void MainWindow::onDetectionReceived(const DetectionResult& result) {
     try {
         qDebug() << "=== DETECTION RECEIVED ===";
-        qDebug() << "Detection frameId:" << result.frameId;
+        qDebug() << "Detection stream:" << result.streamId << "frameId:" << result.frameId;
         qDebug() << "Detection count:" << result.detections.size();
 
-        // Detection ı cache e sakla
-        detectionResults[result.frameId] = result;
+        if (result.streamId != 0) {
+            // Çoklu izlemedeki diğer akışlar: kendi deposu ve tracker'ı
+            if (StreamSession* session = findStream(result.streamId)) {
+                session->scheduler.recordResult(result.roundTripMs);
+                session->store.insert(session->tracker.update(result));
+            }
+            return;
+        }
 
-        // Son geçerli detection ı güncelle
-        lastValidDetection = result;
-        lastDetectionFrameId = result.frameId;
+        detectionScheduler.recordResult(result.roundTripMs);
 
-        qDebug() << "Son detection güncellendi";
+        // trackId'ler atanır, halkaya eklenir (toplamlar ekleme sırasında güncellenir)
+        detectionStore.insert(objectTracker.update(result));
 
-        updateDetectionStats();
+        // Offline analizde sonucu beklenen frame'ler yazılır
+        if (isExporting) {
+            exportIdleTimer.start();
+            flushPendingExports(false);
+            checkExportDrained();
+        }
 
     } catch (const std::exception& e) {
         qDebug() << "Detection handling hatası:" << e.what();
     }
 }
 
+void MainWindow::onDetectionSkipped(int frameId)
+{
+    // Sahne değişmedi: son sonuç bu frame için de geçerli sayılır. Offline analizde
+    // frame sırası bozulmasın diye kopyalama dışa aktarılırken yapılır.
+    if (isExporting) {
+        pendingExports[frameId].skipped = true;
+        flushPendingExports(false);
+        return;
+    }
+    detectionStore.carryForward(frameId);
+}
+
 void MainWindow::onYOLOConnectionChanged(bool connected)
 {
     qDebug() << "MainWindow: YOLO bağlantı durumu:" << (connected ? "Bağlı" : "Bağlı değil");
 
     isYOLOConnected = connected;
     isYOLOEnabled = connected;
+    updateDetectionForwarding();
 
     // UI güncelle
     updateYOLOStatus();
@@ -645,66 +1280,13 @@ void MainWindow::onYOLOError(const QString& error)
 
 
 
-void MainWindow::drawDetections(cv::Mat& frame, const DetectionResult& result) {
-    try {
-        for (const Detection& detection : result.detections) {
-            if (!detection.isValid()) {
-                continue;
-            }
-
-            // Confidence e göre renk belirleme
-            cv::Scalar boxColor;
-            if (detection.confidence > 0.8) {
-                boxColor = cv::Scalar(0, 255, 0);      // Yüksek güven: Yeşil
-            } else if (detection.confidence > 0.5) {
-                boxColor = cv::Scalar(0, 255, 255);    // Orta güven: Sarı
-            } else {
-                boxColor = cv::Scalar(0, 165, 255);    // Düşük güven: Turuncu
-            }
-
-            // Kalınlık confidence'e göre
-            int thickness = detection.confidence > 0.7 ? 3 : 2;
-
-            // Bounding box çiz
-            cv::rectangle(frame, detection.bbox, boxColor, thickness);
-
-            // Label hazırla
-            QString labelText = QString("%1 %2%")
-                                    .arg(detection.className)
-                                    .arg(static_cast<int>(detection.confidence * 100));
-
-            // Text background
-            cv::Size textSize = cv::getTextSize(labelText.toStdString(),
-                                                cv::FONT_HERSHEY_SIMPLEX, 0.7, 2, nullptr);
-
-            cv::Point labelPos(detection.bbox.x, detection.bbox.y - 8);
-            cv::Rect labelRect(labelPos.x, labelPos.y - textSize.height - 8,
-                               textSize.width + 16, textSize.height + 16);
-
-            // Semi-transparent background
-            cv::Mat overlay;
-            frame.copyTo(overlay);
-            cv::rectangle(overlay, labelRect, cv::Scalar(0, 0, 0), -1);
-            cv::addWeighted(frame, 0.7, overlay, 0.3, 0, frame);
-
-            // Label text
-            cv::putText(frame, labelText.toStdString(),
-                        cv::Point(labelPos.x + 8, labelPos.y),
-                        cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(255, 255, 255), 2);
-        }
-
-    } catch (const cv::Exception& e) {
-        qDebug() << "drawDetections OpenCV exception:" << e.what();
-    }
-}
-
 void MainWindow::updateYOLOStatus()
 {
     if (yoloStatusLabel) {
         QString status;
         if (isYOLOConnected) {
             status = QString("YOLO:Connected (%1)")
-                         .arg(yoloCommunicator->getStatus());
+                         .arg(inferenceBackend->getStatus());
         } else {
             status = "YOLO: Disconnected";
         }
@@ -712,15 +1294,14 @@ void MainWindow::updateYOLOStatus()
     }
 }
 
-void MainWindow::updateDetectionStats()
+void MainWindow::updateDetectionForwarding()
 {
-    // Toplam detection sayısını hesapla
-    totalDetectionsCount = 0;
-    for (const auto& result : detectionResults) {
-        totalDetectionsCount += result.detections.size();
+    if (videoController) {
+        videoController->setDetectionEnabled(isYOLOEnabled && isYOLOConnected);
+    }
+    for (const auto& session : extraStreams) {
+        session->controller->setDetectionEnabled(isYOLOEnabled && isYOLOConnected);
     }
-
-    qDebug() << "MainWindow: Toplam detection:" << totalDetectionsCount;
 }
 
 void MainWindow::updateFrameInfo(const FrameData& frameData, bool hasDetection, const DetectionResult& detection) {
@@ -740,21 +1321,13 @@ void MainWindow::updateFrameInfo(const FrameData& frameData, bool hasDetection,
             }
         }
 
-        frameInfoLabel->setText(frameInfo);
-    }
-}
-void MainWindow::cleanupDetectionCache() {
-    const int MAX_CACHE_SIZE = 100; // Son 100 frame i sakla
-
-    if (detectionResults.size() > MAX_CACHE_SIZE) {
-        // En eski detection'ları sil
-        auto it = detectionResults.begin();
-        int toRemove = detectionResults.size() - MAX_CACHE_SIZE;
-
-        for (int i = 0; i < toRemove && it != detectionResults.end(); ++i) {
-            it = detectionResults.erase(it);
+        if (motionAnalyzer.activeCount() > 0) {
+            frameInfo += QString(" | Hareketli: %1, Duran: %2, Park: %3")
+                             .arg(motionAnalyzer.movingCount())
+                             .arg(motionAnalyzer.stationaryCount())
+                             .arg(motionAnalyzer.parkedCount());
         }
 
-        qDebug() << "Detection cache temizlendi, yeni boyut:" << detectionResults.size();
+        frameInfoLabel->setText(frameInfo);
     }
 }
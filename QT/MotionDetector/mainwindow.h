@@ -9,11 +9,24 @@
 #include <QList>
 #include <QCloseEvent>
 #include <qfiledialog.h>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "ai/yolocommunicator.h"
+#include "ai/InferenceBackend.h"
 #include "core/FrameData.h"      // Temel veri yapıları için
+#include "core/DetectionArbiter.h" // Akışlar arası tespit sırası için
+#include "core/DetectionScheduler.h" // Tespit adımının (stride) seçimi için
+#include "core/DetectionStore.h" // Tespit sonuçları deposu için
+#include "core/ObjectTracker.h"  // Tespitler arası nesne takibi için
+#include "core/MotionAnalyzer.h" // İz başına hız ve bekleme süresi için
+#include "core/PresentationClock.h" // PTS tabanlı gösterim saati için
 #include "core/ThreadQueue.h"      // Thread-safe kuyruk için
+#include "core/FramePool.h"        // Decode buffer havuzu için
 #include "core/videocontroller.h" // Video işçisi sınıfı için
+#include "core/overlayrenderer.h" // Tespit çizim işçisi için
+#include "core/resultexporter.h"  // Sonuçların diske yazılması için
 #include "ai/yolocommunicator.h"  // YOLO işçisi sınıfı için
 
 QT_BEGIN_NAMESPACE
@@ -23,13 +36,39 @@ class QLabel;
 class QProgressBar;
 class QListWidgetItem;
 class QCloseEvent;
+class StreamGrid;
+class VideoView;
+
+/*
+ Çoklu izlemede ana video dışındaki bir akışın (streamId >= 1) durumu
+ Her akışın kendi VideoController'ı ve Video Thread'i, görüntüleme kuyruğu,
+ gösterim saati ve tespit deposu vardır. Tespit backend'i, OverlayRenderer ve
+ tespit kuyruğu tüm akışlarca paylaşılır. Hareket analizi ve dışa aktarma
+ sadece ana video için yapılır.
+ */
+struct StreamSession {
+    int streamId = 0;
+    QString videoPath;
+    FrameQueue displayQueue;
+    FramePool framePool;
+    VideoController* controller = nullptr;
+    QThread* thread = nullptr;
+    DetectionScheduler scheduler;
+    DetectionStore store;
+    ObjectTracker tracker;
+    PresentationClock clock;
+    FrameData pendingFrame;
+    bool hasPendingFrame = false;
+    int lastPresentedFrameId = -1;
+    quint64 lateFramesDropped = 0;
+};
 
 
 /*
 
 Uygulamanın ana penceresini ve iş akışını yöneten kısım
 
-Bu sınıf, VideoController ve YOLOCommunicator işçilerini ayrı thread lerde çalıştırır.
+Bu sınıf, VideoController ve tespit (InferenceBackend) işçilerini ayrı thread lerde çalıştırır.
 UI güncellemelerini yapar, kullanıcı etkileşimlerini yönetir ve worker thread lerden
 gelen verileri (görüntülenecek kareler, tespit sonuçları) işler.
  */
@@ -54,12 +93,16 @@ private slots:
 
     void on_pushButton_AddVideo_clicked();
     void on_pushButton_selectVideo_clicked();
+    void on_pushButton_Process_clicked();
     void on_listWidget_Videos_itemDoubleClicked(QListWidgetItem *item);
     void on_pushButton_PlayPause_clicked();
     void on_doubleSpinBox_PlaybackSpeed_valueChanged(double value);
     void on_horizontalSlider_sliderMoved(int position);
     void on_pushButton_SystemStatus_clicked();
     void on_pushButton_ChooseModel_clicked();
+    void on_pushButton_addModel_clicked();
+    void on_comboBox_selectModel_currentIndexChanged(int index);
+    void on_pushButton_MultiStream_clicked();
 
 
     //  Worker Thread lerden Gelen Sinyaller İçin Slotlar
@@ -67,7 +110,12 @@ private slots:
     void onVideoOpened(const VideoInfo& videoInfo);
     void onVideoFinished();
     void onProgressChanged(double progress);
+    void onSeekFinished(int frameNumber);
+    void onVideoSwitched(const VideoInfo& videoInfo, int firstFrameId);
+    void onOverlayRendered(const FrameData& frameData);
+    void onIndexReady(int keyframeCount);
     void onDetectionReceived(const DetectionResult& result);
+    void onDetectionSkipped(int frameId);
     void onYOLOConnectionChanged(bool connected);
     void onYOLOError(const QString& error);
 
@@ -91,15 +139,30 @@ private:
     void setupStatusBar();
     void setupTimers();
     void setupThreads();
-    void startVideoProcessing(const QString& videoPath);
+    void installInferenceBackend(InferenceBackend* backend);
+    bool takeDueFrame(FrameQueue& queue, PresentationClock& clock, FrameData& pending,
+                      bool& hasPending, quint64& lateDropped, FrameData& frameToShow);
+    void stepFrame(int delta);
+    void startVideoProcessing(const QString& videoPath, bool offline = false);
     void stopVideoProcessing();
+    void preloadNextVideo();
+    void startMultiStream(const QStringList& videoPaths);
+    bool startExtraStream(const QString& videoPath, int streamId);
+    void stopExtraStreams();
+    void presentStream(StreamSession& session);
+    StreamSession* findStream(int streamId) const;
+    void setMultiStreamView(int streamCount);
+    VideoView* viewForStream(int streamId) const;
 
 
     //  Yardımcı ve UI Güncelleme Fonksiyonları
 
     void displayFrame(const FrameData& frameData);
-    void drawDetections(cv::Mat& frame, const DetectionResult& result);
-    QPixmap matToQPixmap(const cv::Mat& frame);
+    bool analyzeFrame(const FrameData& frameData, DetectionResult& detections);
+    void exportFrame(const FrameData& frameData, const DetectionResult& detections);
+    void queueExport(const FrameData& frameData);
+    void flushPendingExports(bool force);
+    void checkExportDrained();
     QString selectVideoFile();
     void addVideoToList(const QString& filePath);
     void updateStatusBar(const QString& message);
@@ -109,9 +172,8 @@ private:
     void updatePerformanceInfo(const PerformanceStats& stats);
     void updateSeekSlider(double progress);
     void updateYOLOStatus();
-    void updateDetectionStats();
+    void updateDetectionForwarding();
     void updateFrameInfo(const FrameData& frameData, bool hasDetection, const DetectionResult& detection);
-    void cleanupDetectionCache();
 
 
     Ui::MainWindow *ui;                      // Qt Designer ile oluşturulan UI elemanlarına erişim pointer ı.
@@ -119,16 +181,33 @@ private:
     //  Thread ler arası iletişim için Kuyruklar
     FrameQueue displayQueue;                 // Video->UI: Görüntülenecek tüm kareleri tutan kuyruk.
     FrameQueue detectionQueue;               // Video->YOLO: Tespit edilecek kareleri (örn. her 6. kare) tutan kuyruk.
+    FramePool framePool;                     // Decode edilen karelerin tekrar kullanılan buffer havuzu.
 
     //  Worker Sınıfları ve Onları Çalıştıran Thread ler
     VideoController *videoController;        // Video okuma işçisi.
-    YOLOCommunicator *yoloCommunicator;      // YOLO/TCP iletişim işçisi.
+    InferenceBackend *inferenceBackend;      // Aktif tespit işçisi (Python/TCP ya da ONNX).
     QThread *videoThread;                    // videoController ı çalıştıran thread.
-    QThread *yoloThread;                     // yoloCommunicator ı çalıştıran thread.
+    QThread *yoloThread;                     // inferenceBackend i çalıştıran thread.
+    OverlayRenderer *overlayRenderer;        // Tespit kutularını çizen işçi.
+    QThread *overlayThread;                  // overlayRenderer ı çalıştıran thread.
+    ResultExporter *resultExporter;          // Sonuçları CSV/JSONL olarak yazan işçi.
+    QThread *exportThread;                   // resultExporter ı çalıştıran thread.
+    int lastPresentedFrameId = -1;           // Ekrana basılan son frame (geç gelen çizimleri elemek için)
+
+    //  Çoklu izleme (ana video streamId 0, diğerleri extraStreams)
+    static constexpr int MaxGridStreams = 4;
+    std::vector<std::unique_ptr<StreamSession>> extraStreams;
+    DetectionArbiter detectionArbiter;       // Akışların tespit kuyruğuna sırayla erişimi
+    StreamGrid* streamGrid = nullptr;        // Çoklu izlemede videoView yerine gösterilen ızgara
+    bool isMultiStream = false;
 
     //  Ana Thread Zamanlayıcıları
     QTimer* displayTimer = nullptr;                   // Görüntüleme kuyruğunu kontrol eden zamanlayıcı.
     QTimer* uiUpdateTimer = nullptr;                   // FPS gibi UI bileşenlerini güncelleyen zamanlayıcı.
+    PresentationClock presentationClock;     // Frame'leri timeStamp'e göre gösterme saati.
+    FrameData pendingFrame;                  // Kuyruktan alınmış, gösterim zamanı gelmemiş frame.
+    bool hasPendingFrame = false;
+    quint64 lateFramesDropped = 0;           // Gösterim zamanı geçtiği için atlanan frame'ler.
     QElapsedTimer fpsTimer;                  // FPS hesaplaması için geçen süreyi ölçer.
 
     //  Status Bar Elemanları
@@ -146,16 +225,30 @@ private:
     bool isYOLOConnected = false;
     bool isYOLOEnabled = false;
     bool isPlaying = false;
+    bool isOfflineRun = false;               // İŞLE ile başlatılan offline analiz
+    bool isExporting = false;                // Offline analiz sonuçları dışa aktarılıyor
+    bool exportDraining = false;             // Video bitti, son tespit sonuçları bekleniyor
     int frameCounter = 0;
     double currentDisplayFPS = 0.0;
-    int totalDetectionsCount = 0;
     FrameData currentFrameData;              // UI da en son gösterilen kare verisi.
 
     //  Tespit Sonuçları Önbelleği (Cache)
-    QMap<int, DetectionResult> detectionResults; // Frame ID sine göre tespit sonuçlarını saklar.
-    DetectionResult lastValidDetection;      // Ekranda gösterilen son geçerli tespit.
-    int lastDetectionFrameId = -1;
-    const int DETECTION_PERSISTENCE = 15;     // Bir tespitin ekranda kalma süresi (kare sayısı).
+    DetectionScheduler detectionScheduler;   // Gecikme ve kuyruk doluluğuna göre tespit edilecek frame'leri seçer.
+    DetectionStore detectionStore;           // frameId ile indekslenen sabit kapasiteli tespit halkası.
+    ObjectTracker objectTracker;             // trackId atar, tespitler arasındaki kutuları tahmin eder.
+    MotionAnalyzer motionAnalyzer;           // Gösterilen kutulardan hız, duruş ve park süresi.
+    const int DETECTION_PERSISTENCE = 24;     // İki tespit arasında ara değerleme yapılacak en fazla kare (> en büyük stride).
+
+    //  Offline Dışa Aktarma (sonuç yolunda, frameId sırasıyla)
+    struct PendingExport {
+        FrameData header;                    // Piksel verisi tutulmaz, havuz slab'ı hemen döner
+        bool hasHeader = false;              // Frame ekran kuyruğundan alındı
+        bool skipped = false;                // Hareket olmadığı için tespite gönderilmedi
+    };
+    std::map<int, PendingExport> pendingExports; // Sonucu beklenen frame'ler
+    DetectionResult lastExported;            // Atlanan frame'lere aynen yazılır
+    QElapsedTimer exportIdleTimer;           // Video bittikten sonra son sonuçtan bu yana geçen süre
+    const int EXPORT_DRAIN_TIMEOUT_MS = 10000; // Gelmeyen sonuçlar için en fazla bu kadar beklenir
     void setupSignalConnections();
     void cleanupThreads();
 };
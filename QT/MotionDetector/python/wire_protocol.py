@@ -0,0 +1,183 @@
+# This Python file uses the following encoding: utf-8
+"""C++ tarafıyla aynı binary mesaj formatı (ai/WireProtocol.h ile birebir aynı olmalı)
+
+Socket üzerinde her mesaj 4 byte big-endian uzunluk + gövde şeklindedir.
+Gövde 8 byte'lık ortak başlıkla başlar: magic "MDPB" | version | type | reserved
+"""
+import struct
+
+import cv2
+import numpy as np
+
+MAGIC = b'MDPB'
+VERSION = 1
+
+MSG_FRAME_REQUEST = 1
+MSG_DETECTION_RESULT = 2
+MSG_HELLO = 3
+MSG_ERROR = 4
+MSG_SHM_ATTACH = 5
+MSG_SHM_ATTACH_ACK = 6
+MSG_BATCH_REQUEST = 7
+
+PIXEL_BGR8 = 1
+PIXEL_GRAY8 = 2
+
+CODEC_RAW = 0
+CODEC_JPEG = 1
+CODEC_SHARED_MEMORY = 2
+
+# DetectionResult flags alanı
+RESULT_FAILED = 0x0001  # Frame çözülemedi, tespit yapılmadı
+
+HEADER = struct.Struct('>4sBBH')
+FRAME_HEADER = struct.Struct('>iHHBBHI')
+RESULT_HEADER = struct.Struct('>ifHH')
+DETECTION_RECORD = struct.Struct('>HHfhhhh')
+SHM_ATTACH = struct.Struct('>HBBI')
+BATCH_HEADER = struct.Struct('>HH')
+
+# ai/SharedFrameRing.h ile aynı: 64 byte başlık, ardından slot'lar
+SHM_HEADER_SIZE = 64
+SHM_HEADER = struct.Struct('<4sIII')
+SHM_MAGIC = b'MDSH'
+
+
+class SharedFrameRing:
+    """C++ tarafının oluşturduğu shared memory segmentine bağlanır"""
+
+    def __init__(self, name, slot_count, slot_size):
+        from multiprocessing import shared_memory
+
+        self.shm = shared_memory.SharedMemory(name=name, create=False)
+        try:
+            # Segmentin sahibi C++; Python çıkarken resource_tracker silmesin
+            from multiprocessing import resource_tracker
+            resource_tracker.unregister(self.shm._name, 'shared_memory')
+        except Exception:
+            pass
+
+        magic, _, header_slots, header_slot_size = SHM_HEADER.unpack_from(self.shm.buf, 0)
+        if magic != SHM_MAGIC or header_slots != slot_count or header_slot_size != slot_size:
+            self.close()
+            raise ValueError('Shared memory başlığı uyuşmuyor')
+
+        self.slot_count = slot_count
+        self.slot_size = slot_size
+
+    def frame(self, slot, width, height, channels):
+        """Slot içindeki pikselleri kopyalamadan ndarray olarak döndür"""
+        if not 0 <= slot < self.slot_count:
+            return None
+        offset = SHM_HEADER_SIZE + slot * self.slot_size
+        size = width * height * channels
+        return np.frombuffer(self.shm.buf, np.uint8, count=size, offset=offset).reshape(height, width, channels)
+
+    def close(self):
+        try:
+            self.shm.close()
+        except Exception:
+            pass
+
+
+def is_binary(body):
+    """Gövde binary protokole mi ait, yoksa eski JSON mesajı mı?"""
+    return len(body) >= HEADER.size and body[:4] == MAGIC
+
+
+def message_type(body):
+    magic, version, msg_type, _ = HEADER.unpack_from(body, 0)
+    if magic != MAGIC or version != VERSION:
+        return None
+    return msg_type
+
+
+def _decode_frame_at(body, offset, shared_ring):
+    """offset'teki frame gövdesini çöz, (frame_id, frame, sonraki offset) döndürür"""
+    frame_id, width, height, pixel_format, codec, _, data_size = FRAME_HEADER.unpack_from(body, offset)
+    offset += FRAME_HEADER.size
+    data = memoryview(body)[offset:offset + data_size]
+    channels = 1 if pixel_format == PIXEL_GRAY8 else 3
+
+    # Piksel verisi bozuksa frame None döner, frame_id ile hata cevabı verilebilir
+    frame = None
+    try:
+        if codec == CODEC_SHARED_MEMORY:
+            if shared_ring is not None:
+                slot = struct.unpack_from('>I', data, 0)[0]
+                frame = shared_ring.frame(slot, width, height, channels)
+                if frame is not None and channels == 1:
+                    frame = cv2.cvtColor(frame, cv2.COLOR_GRAY2BGR)
+        elif codec == CODEC_JPEG:
+            flags = cv2.IMREAD_GRAYSCALE if pixel_format == PIXEL_GRAY8 else cv2.IMREAD_COLOR
+            frame = cv2.imdecode(np.frombuffer(data, np.uint8), flags)
+        else:
+            frame = np.frombuffer(data, np.uint8).reshape(height, width, channels)
+            if channels == 1:
+                frame = cv2.cvtColor(frame, cv2.COLOR_GRAY2BGR)
+    except (ValueError, struct.error, cv2.error) as e:
+        print(f" Frame {frame_id} çözülemedi: {e}")
+        frame = None
+
+    return frame_id, frame, offset + data_size
+
+
+def decode_frame_request(body, shared_ring=None):
+    """Frame isteğini çöz, (frame_id, frame) döndürür"""
+    frame_id, frame, _ = _decode_frame_at(body, HEADER.size, shared_ring)
+    return frame_id, frame
+
+
+def decode_batch_request(body, shared_ring=None):
+    """Toplu isteği çöz, [(frame_id, frame), ...] döndürür"""
+    count, _ = BATCH_HEADER.unpack_from(body, HEADER.size)
+    offset = HEADER.size + BATCH_HEADER.size
+    frames = []
+    for _ in range(count):
+        frame_id, frame, offset = _decode_frame_at(body, offset, shared_ring)
+        frames.append((frame_id, frame))
+    return frames
+
+
+def _clamp_i16(value):
+    return max(-32768, min(32767, int(value)))
+
+
+def encode_detection_result(frame_id, detections, processing_time_ms, failed=False):
+    """Tespitleri paketlenmiş kayıtlar halinde gövdeye yaz
+
+    detections: (class_id, confidence, x1, y1, x2, y2) demetleri
+    failed: frame çözülemedi, C++ tarafı isteği sonuçsuz kapatır
+    """
+    flags = RESULT_FAILED if failed else 0
+    parts = [HEADER.pack(MAGIC, VERSION, MSG_DETECTION_RESULT, 0),
+             RESULT_HEADER.pack(frame_id, float(processing_time_ms), len(detections), flags)]
+    for class_id, confidence, x1, y1, x2, y2 in detections:
+        parts.append(DETECTION_RECORD.pack(class_id, 0, float(confidence),
+                                           _clamp_i16(x1), _clamp_i16(y1),
+                                           _clamp_i16(x2), _clamp_i16(y2)))
+    return b''.join(parts)
+
+
+def encode_hello(input_size, class_names):
+    """Bağlantı başında model bilgilerini gönder (sınıf adı tablosu)"""
+    parts = [HEADER.pack(MAGIC, VERSION, MSG_HELLO, 0),
+             struct.pack('>HH', input_size, len(class_names))]
+    for name in class_names:
+        encoded = name.encode('utf-8')[:255]
+        parts.append(struct.pack('>B', len(encoded)))
+        parts.append(encoded)
+    return b''.join(parts)
+
+
+def decode_shm_attach(body):
+    """(name, slot_count, slot_size) döndürür"""
+    offset = HEADER.size
+    slot_count, name_len, _, slot_size = SHM_ATTACH.unpack_from(body, offset)
+    offset += SHM_ATTACH.size
+    name = bytes(body[offset:offset + name_len]).decode('utf-8')
+    return name, slot_count, slot_size
+
+
+def encode_shm_attach_ack(attached):
+    return HEADER.pack(MAGIC, VERSION, MSG_SHM_ATTACH_ACK, 0) + struct.pack('>BBBB', 1 if attached else 0, 0, 0, 0)
@@ -1,5 +1,6 @@
 # if __name__ == "__main__":
 #     pass
+import argparse
 import socket
 import json
 import struct
@@ -7,10 +8,28 @@ import base64
 import cv2
 import numpy as np
 from ultralytics import YOLO
+import os
 import time
+import queue
+import threading
+
+import wire_protocol
+
+CONFIG_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'config.json')
+
+
+def load_config(path=CONFIG_PATH):
+    """config.json'u oku, yoksa ya da bozuksa boş ayar döndür"""
+    try:
+        with open(path, 'r', encoding='utf-8') as f:
+            return json.load(f)
+    except (OSError, ValueError) as e:
+        print(f" config.json okunamadı ({e}), varsayılanlar kullanılıyor")
+        return {}
+
 
 class SimpleYOLOService:
-    def __init__(self):
+    def __init__(self, host='localhost', port=8888):
         print(" YOLO Service başlatılıyor...")
 
         # YOLO modelini yükle
@@ -22,10 +41,17 @@ class SimpleYOLOService:
             self.model = None
 
         # Server ayarları
-        self.host = 'localhost'
-        self.port = 8888
+        self.host = host
+        self.port = port
         self.socket = None
 
+        # Modelin giriş boyutu (config.json -> image_size). Hello ile C++'a bildirilir,
+        # C++ tarafı frame'leri bu boyuta letterbox'lar.
+        self.image_size = int(load_config().get('image_size', 640))
+
+        # C++ shared memory halkası (aynı makinedeyse)
+        self.shared_ring = None
+
         # Basit sayaçlar
         self.frame_count = 0
         self.detection_count = 0
@@ -39,14 +65,18 @@ class SimpleYOLOService:
             self.socket.listen(1)
 
             print(f"  Server başlatıldı: {self.host}:{self.port}")
-            print("  C++ bağlantısı bekleniyor...")
 
-            # C++'dan bağlantı bekle
-            client_socket, client_address = self.socket.accept()
-            print(f"C++ bağlandı: {client_address}")
+            # Bağlantı kapanınca yenisi beklenir, C++ tarafı yeniden bağlanabilir
+            while True:
+                print("  C++ bağlantısı bekleniyor...")
+                client_socket, client_address = self.socket.accept()
+                print(f"C++ bağlandı: {client_address}")
+
+                # Model bilgilerini binary protokol ile bildir
+                self.send_hello(client_socket)
 
-            # Frame işleme döngüsü
-            self.process_frames(client_socket)
+                # Frame işleme döngüsü
+                self.process_frames(client_socket)
 
         except Exception as e:
             print(f" Server hatası: {e}")
@@ -59,14 +89,32 @@ class SimpleYOLOService:
         """C++'dan gelen frame'leri işle"""
         print(" Frame işleme başladı...")
 
+        # C++ birden fazla isteği cevap beklemeden gönderir. Okuma ayrı thread'de
+        # yapılır, böylece model çalışırken sıradaki frame'ler socket'ten alınır.
+        inbox = queue.Queue(maxsize=16)
+        reader = threading.Thread(target=self.reader_loop, args=(client_socket, inbox), daemon=True)
+        reader.start()
+
         try:
             while True:
-                # C++ dan mesaj al
-                message = self.receive_message(client_socket)
-                if not message:
+                # Okuma thread'inden sıradaki mesajı al
+                body = inbox.get()
+                if body is None:
                     break
 
-                # Frame i işle
+                if wire_protocol.is_binary(body):
+                    # Binary protokol: sabit başlık + ham/JPEG piksel verisi
+                    msg_type = wire_protocol.message_type(body)
+                    if msg_type == wire_protocol.MSG_FRAME_REQUEST:
+                        self.handle_binary_frame(client_socket, body)
+                    elif msg_type == wire_protocol.MSG_BATCH_REQUEST:
+                        self.handle_batch(client_socket, body)
+                    elif msg_type == wire_protocol.MSG_SHM_ATTACH:
+                        self.handle_shm_attach(client_socket, body)
+                    continue
+
+                # Eski JSON protokolü (geriye dönük uyumluluk)
+                message = json.loads(body.decode('utf-8'))
                 if message.get('type') == 'frame_request':
                     self.handle_frame(client_socket, message)
 
@@ -75,47 +123,133 @@ class SimpleYOLOService:
         except Exception as e:
             print(f"Frame işleme hatası: {e}")
         finally:
+            if self.shared_ring is not None:
+                self.shared_ring.close()
+                self.shared_ring = None
             client_socket.close()
             print(" C++ bağlantısı kapatıldı")
 
-    def receive_message(self, client_socket):
-        """C++'dan JSON mesaj al"""
+    def reader_loop(self, client_socket, inbox):
+        """Socket'ten gelen mesajları kesintisiz okuyup kuyruğa koy"""
+        while True:
+            body = self.receive_body(client_socket)
+            inbox.put(body)
+            if body is None:
+                return
+
+    def recv_exact(self, client_socket, size):
+        """Tam olarak size byte gelene kadar oku"""
+        data = bytearray()
+        while len(data) < size:
+            chunk = client_socket.recv(size - len(data))
+            if not chunk:
+                return None
+            data += chunk
+        return bytes(data)
+
+    def receive_body(self, client_socket):
+        """C++'dan uzunluk prefix'li bir mesaj gövdesi al"""
         try:
             # İlk 4 byte = mesaj boyutu
-            size_data = client_socket.recv(4)
+            size_data = self.recv_exact(client_socket, 4)
             if not size_data:
                 return None
 
             message_size = struct.unpack('>I', size_data)[0]
-
-            # JSON mesajını al
-            json_data = b''
-            while len(json_data) < message_size:
-                chunk = client_socket.recv(message_size - len(json_data))
-                if not chunk:
-                    return None
-                json_data += chunk
-
-            # JSON parse et
-            message = json.loads(json_data.decode('utf-8'))
-            return message
+            return self.recv_exact(client_socket, message_size)
 
         except Exception as e:
             print(f" Mesaj alma hatası: {e}")
             return None
 
+    def send_body(self, client_socket, body):
+        """Gövdeyi uzunluk prefix'i ile gönder"""
+        try:
+            client_socket.sendall(struct.pack('>I', len(body)) + body)
+        except Exception as e:
+            print(f"Mesaj gönderme hatası: {e}")
+
     def send_message(self, client_socket, message):
         """C++ a JSON mesaj gönder"""
+        self.send_body(client_socket, json.dumps(message).encode('utf-8'))
+
+    def send_hello(self, client_socket):
+        """Sınıf adlarını ve giriş boyutunu bir kez gönder"""
+        names = []
+        if self.model is not None:
+            model_names = self.model.names
+            names = [model_names[i] for i in sorted(model_names)]
+        self.send_body(client_socket, wire_protocol.encode_hello(self.image_size, names))
+
+    def handle_shm_attach(self, client_socket, body):
+        """C++'ın oluşturduğu shared memory segmentine bağlan ve sonucu bildir"""
+        attached = False
+        try:
+            name, slot_count, slot_size = wire_protocol.decode_shm_attach(body)
+            if self.shared_ring is not None:
+                self.shared_ring.close()
+            self.shared_ring = wire_protocol.SharedFrameRing(name, slot_count, slot_size)
+            attached = True
+            print(f" Shared memory bağlandı: {name} ({slot_count} slot)")
+        except Exception as e:
+            # Desteklenmiyorsa C++ TCP ile göndermeye devam eder
+            print(f" Shared memory bağlanamadı: {e}")
+            self.shared_ring = None
+
+        self.send_body(client_socket, wire_protocol.encode_shm_attach_ack(attached))
+
+    def handle_binary_frame(self, client_socket, body):
+        """Binary frame isteğini işle, paketlenmiş tespit kayıtlarıyla cevap ver"""
+        try:
+            frame_id, frame = wire_protocol.decode_frame_request(body, self.shared_ring)
+            if frame is None:
+                # Cevapsız kalan istek C++ tarafında zaman aşımına kadar bekler
+                print(" Frame decode edilemedi")
+                self.send_body(client_socket,
+                               wire_protocol.encode_detection_result(frame_id, [], 0.0, failed=True))
+                return
+
+            start = time.perf_counter()
+            detections = self.run_model(frame)
+            elapsed_ms = (time.perf_counter() - start) * 1000.0
+
+            self.send_body(client_socket,
+                           wire_protocol.encode_detection_result(frame_id, detections, elapsed_ms))
+
+            self.frame_count += 1
+            self.detection_count += len(detections)
+
+        except Exception as e:
+            print(f"Frame işleme hatası: {e}")
+
+    def handle_batch(self, client_socket, body):
+        """Toplu isteği tek model çağrısıyla işle, her frame için ayrı sonuç gönder"""
         try:
-            # JSON'a çevir
-            json_data = json.dumps(message).encode('utf-8')
+            decoded = wire_protocol.decode_batch_request(body, self.shared_ring)
+            items = [(frame_id, frame) for frame_id, frame in decoded if frame is not None]
+
+            # Çözülemeyen frame'ler için de cevap gider, C++ tarafı onları beklemez
+            for frame_id, frame in decoded:
+                if frame is None:
+                    self.send_body(client_socket,
+                                   wire_protocol.encode_detection_result(frame_id, [], 0.0, failed=True))
+            if not items:
+                print(" Batch decode edilemedi")
+                return
 
-            # Boyut + JSON gönder
-            size = struct.pack('>I', len(json_data))
-            client_socket.send(size + json_data)
+            start = time.perf_counter()
+            batch_detections = self.run_model_batch([frame for _, frame in items])
+            # Batch süresi frame'lere bölünür, C++ tarafı frame başına süre bekler
+            elapsed_ms = (time.perf_counter() - start) * 1000.0 / len(items)
+
+            for (frame_id, _), detections in zip(items, batch_detections):
+                self.send_body(client_socket,
+                               wire_protocol.encode_detection_result(frame_id, detections, elapsed_ms))
+                self.frame_count += 1
+                self.detection_count += len(detections)
 
         except Exception as e:
-            print(f"Mesaj gönderme hatası: {e}")
+            print(f"Batch işleme hatası: {e}")
 
     def handle_frame(self, client_socket, message):
         """Frame'i YOLO ile işle ve sonuç gönder"""
@@ -173,51 +307,53 @@ class SimpleYOLOService:
             print(f" Frame decode hatası: {e}")
             return None
 
-    def detect_objects(self, frame, frame_id):
-        """YOLO ile nesne tespiti yap"""
+    def run_model(self, frame):
+        """YOLO inference, (class_id, confidence, x1, y1, x2, y2) listesi döndürür"""
+        return self.run_model_batch([frame])[0]
+
+    def run_model_batch(self, frames):
+        """Frame listesini tek batch olarak modele ver, frame başına tespit listesi döndürür"""
         if self.model is None:
             print(" Model yüklü değil")
-            return []
+            return [[] for _ in frames]
 
         try:
-            # YOLO inference
-            results = self.model(frame, verbose=False)
-
-            detections = []
+            # C++ tarafı büyük frame'leri bu boyuta letterbox'layıp gönderir
+            results = self.model(frames, imgsz=self.image_size, verbose=False)
 
-            # Sonuçları işle
+            batch_detections = []
             for r in results:
+                detections = []
                 boxes = r.boxes
                 if boxes is not None:
-                    for box in boxes:
-                        # Bounding box koordinatları
-                        x1, y1, x2, y2 = box.xyxy[0].tolist()
-
-                        # Class ve confidence
-                        class_id = int(box.cls[0])
-                        confidence = float(box.conf[0])
-                        class_name = self.model.names[class_id]
-
+                    # Tensörleri tek seferde CPU'ya al, kutu başına .tolist() yapma
+                    xyxy = boxes.xyxy.cpu().numpy()
+                    classes = boxes.cls.cpu().numpy().astype(int)
+                    confidences = boxes.conf.cpu().numpy()
+                    for (x1, y1, x2, y2), class_id, confidence in zip(xyxy, classes, confidences):
                         # Minimum confidence kontrolü
                         if confidence > 0.3:
-                            detection = {
-                                'class_id': class_id,
-                                'class_name': class_name,
-                                'confidence': confidence,
-                                'bbox': {
-                                    'x1': int(x1),
-                                    'y1': int(y1),
-                                    'x2': int(x2),
-                                    'y2': int(y2)
-                                }
-                            }
-                            detections.append(detection)
-
-            return detections
+                            detections.append((int(class_id), float(confidence),
+                                               int(x1), int(y1), int(x2), int(y2)))
+                batch_detections.append(detections)
+
+            return batch_detections
 
         except Exception as e:
             print(f" YOLO inference hatası: {e}")
-            return []
+            return [[] for _ in frames]
+
+    def detect_objects(self, frame, frame_id):
+        """YOLO ile nesne tespiti yap (JSON protokolü için)"""
+        detections = []
+        for class_id, confidence, x1, y1, x2, y2 in self.run_model(frame):
+            detections.append({
+                'class_id': class_id,
+                'class_name': self.model.names[class_id],
+                'confidence': confidence,
+                'bbox': {'x1': x1, 'y1': y1, 'x2': x2, 'y2': y2}
+            })
+        return detections
 
     def print_stats(self):
         """Basit istatistikler"""
@@ -228,10 +364,25 @@ class SimpleYOLOService:
             print(f"   Ortalama tespit/frame: {self.detection_count/self.frame_count:.1f}")
 
 if __name__ == "__main__":
+    # Çok çekirdekli makinede birden fazla servis farklı portlarda çalıştırılır,
+    # C++ tarafı frame'leri en az yüklü olana gönderir (--endpoints):
+    #   python yolo_service.py --port 8888 --threads 8
+    #   python yolo_service.py --port 8889 --threads 8
+    parser = argparse.ArgumentParser(description="YOLO tespit servisi")
+    parser.add_argument('--host', default='localhost', help="Dinlenecek adres")
+    parser.add_argument('--port', type=int, default=8888, help="Dinlenecek port")
+    parser.add_argument('--threads', type=int, default=0,
+                        help="Modelin kullanacağı CPU thread sayısı (0: varsayılan)")
+    args = parser.parse_args()
+
     print(" YOLO Service")
     print("======================")
 
-    service = SimpleYOLOService()
+    if args.threads > 0:
+        import torch
+        torch.set_num_threads(args.threads)
+
+    service = SimpleYOLOService(args.host, args.port)
 
     try:
         service.start_server()
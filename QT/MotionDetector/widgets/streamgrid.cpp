@@ -0,0 +1,44 @@
+#include "streamgrid.h"
+#include <QGridLayout>
+#include <cmath>
+
+StreamGrid::StreamGrid(QWidget *parent)
+    : QWidget(parent),
+    layout(new QGridLayout(this))
+{
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(2);
+}
+
+void StreamGrid::setStreamCount(int count)
+{
+    count = qMax(0, count);
+    if (count == views.size()) {
+        return;
+    }
+
+    for (VideoView* view : views) {
+        layout->removeWidget(view);
+        delete view;
+    }
+    views.clear();
+
+    const int columns = qMax(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    for (int i = 0; i < count; ++i) {
+        auto* view = new VideoView(this);
+        layout->addWidget(view, i / columns, i % columns);
+        views.append(view);
+    }
+}
+
+VideoView* StreamGrid::view(int index) const
+{
+    return index >= 0 && index < views.size() ? views[index] : nullptr;
+}
+
+void StreamGrid::clearFrames()
+{
+    for (VideoView* view : views) {
+        view->clear();
+    }
+}
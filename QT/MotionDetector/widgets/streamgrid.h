@@ -0,0 +1,35 @@
+#ifndef STREAMGRID_H
+#define STREAMGRID_H
+
+#include "widgets/videoview.h"
+#include <QVector>
+#include <QWidget>
+
+class QGridLayout;
+
+/*
+ Çoklu izlemede akışları yan yana gösteren ızgara
+ Her akış için bir VideoView oluşturulur, sütun sayısı akış sayısının
+ kareköküne göre seçilir (2 akış: 2x1, 4 akış: 2x2). Görünümler akış
+ sayısı değişene kadar tekrar kullanılır. Sadece Ana Thread'den kullanılır.
+ */
+class StreamGrid : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StreamGrid(QWidget *parent = nullptr);
+
+    void setStreamCount(int count);
+    int streamCount() const { return views.size(); }
+
+    // streamId sırasıyla, aralık dışındaysa nullptr
+    VideoView* view(int index) const;
+    void clearFrames();
+
+private:
+    QGridLayout* layout;
+    QVector<VideoView*> views;
+};
+
+#endif // STREAMGRID_H
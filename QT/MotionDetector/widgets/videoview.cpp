@@ -0,0 +1,91 @@
+#include "videoview.h"
+#include <QPainter>
+
+VideoView::VideoView(QWidget *parent)
+    : QWidget(parent)
+{
+    // Arka plan her çizimde kendimiz dolduruyoruz, Qt'nin ayrıca silmesine gerek yok
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void VideoView::setFrame(const cv::Mat& newFrame)
+{
+    if (newFrame.empty()) {
+        clear();
+        return;
+    }
+
+    QImage::Format format;
+    if (newFrame.type() == CV_8UC3) {
+        format = QImage::Format_BGR888;
+        frame = newFrame;
+    } else if (newFrame.type() == CV_8UC1) {
+        format = QImage::Format_Grayscale8;
+        frame = newFrame;
+    } else if (newFrame.type() == CV_8UC4) {
+        format = QImage::Format_ARGB32; // OpenCV BGRA, little-endian'da ARGB32 ile aynı düzen
+        frame = newFrame;
+    } else {
+        // Desteklenmeyen derinlik, tek seferlik dönüşüm
+        newFrame.convertTo(frame, CV_8U);
+        if (frame.channels() != 3) {
+            cv::cvtColor(frame, frame, frame.channels() == 1 ? cv::COLOR_GRAY2BGR : cv::COLOR_BGRA2BGR);
+        }
+        format = QImage::Format_BGR888;
+    }
+
+    const QSize previousSize = image.size();
+    // QImage veriyi kopyalamaz, frame üyesi buffer'ı canlı tutar
+    image = QImage(frame.data, frame.cols, frame.rows, static_cast<qsizetype>(frame.step[0]), format);
+    if (image.size() != previousSize) {
+        updateTargetRect();
+    }
+    update();
+}
+
+void VideoView::clear()
+{
+    image = QImage();
+    frame.release();
+    targetRect = QRect();
+    update();
+}
+
+void VideoView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    updateTargetRect();
+}
+
+void VideoView::updateTargetRect()
+{
+    if (image.isNull()) {
+        targetRect = QRect();
+        return;
+    }
+    QSize scaled = image.size();
+    scaled.scale(size(), Qt::KeepAspectRatio);
+    targetRect = QRect(QPoint(0, 0), scaled);
+    targetRect.moveCenter(rect().center());
+}
+
+void VideoView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    if (image.isNull()) {
+        painter.fillRect(rect(), Qt::black);
+        return;
+    }
+
+    // Sadece frame dışında kalan şeritler doldurulur
+    const QRegion bars = QRegion(rect()).subtracted(QRegion(targetRect));
+    for (const QRect& bar : bars) {
+        painter.fillRect(bar, Qt::black);
+    }
+
+    // Ölçekleme ve BGR -> ekran formatı dönüşümü tek geçişte yapılır
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, targetRect.size() != image.size());
+    painter.drawImage(targetRect, image);
+}
@@ -0,0 +1,43 @@
+#ifndef VIDEOVIEW_H
+#define VIDEOVIEW_H
+
+#include <QImage>
+#include <QRect>
+#include <QWidget>
+#include <opencv2/opencv.hpp>
+
+/*
+ Video frame'lerini kopyalamadan gösteren widget
+ cv::Mat buffer'ı QImage::Format_BGR888 olarak sarılır, renk dönüşümü ve
+ ölçekleme paintEvent içinde tek bir çizim geçişinde yapılır. Hedef dikdörtgen
+ (en-boy oranı korunarak) sadece widget ya da frame boyutu değişince hesaplanır.
+ Sadece Ana Thread'den kullanılır.
+ */
+class VideoView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit VideoView(QWidget *parent = nullptr);
+
+    // Frame'in referansı tutulur, çizim bitene kadar buffer canlı kalır.
+    // Pool slab'ı yeniden kullanılmadan önce son referans bu widget'ta düşer.
+    void setFrame(const cv::Mat& frame);
+    void clear();
+
+    bool hasFrame() const { return !image.isNull(); }
+    QSize frameSize() const { return image.size(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateTargetRect();
+
+    cv::Mat frame;      // QImage'ın gösterdiği buffer
+    QImage image;       // frame.data üzerine kopyasız sarmalayıcı
+    QRect targetRect;   // Widget içinde frame'in çizileceği alan
+};
+
+#endif // VIDEOVIEW_H